@@ -0,0 +1,83 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef LOSERTREE_H
+#define LOSERTREE_H
+
+#include <vector>
+#include <cstddef>
+
+namespace Container {
+    /**
+     * @brief Tournament (loser) tree selecting the next of k sorted sources.
+     *
+     * Internal node n (1..k-1) keeps the source that lost the match played there, node 0
+     * the overall winner; source i is the virtual leaf k + i. After the winner's source
+     * advances, replay() walks the single leaf-to-root path, comparing against the stored
+     * losers only, so every step costs ceil(log2 k) comparisons.
+     *
+     * The tree does not own the sources: the caller passes a predicate before(a, b) telling
+     * whether the head of source a goes before the head of source b. It must be a strict
+     * weak order over sources, with exhausted sources ordered last.
+     */
+    class LoserTree {
+        size_t k = 0;
+        std::vector<size_t> nodes;
+
+        template<typename Before>
+        size_t play(size_t node, Before &before) {
+            if (node >= k) return node - k;
+            const size_t left = play(2 * node, before);
+            const size_t right = play(2 * node + 1, before);
+            if (before(right, left)) {
+                nodes[node] = left;
+                return right;
+            }
+            nodes[node] = right;
+            return left;
+        }
+
+    public:
+        /**
+         * @brief Plays the whole tournament for a new set of sources.
+         * @param sources Number of sources (k); at least 1 before top() is used.
+         * @param before Ordering predicate over source indices.
+         */
+        template<typename Before>
+        void reset(size_t sources, Before before) {
+            k = sources;
+            nodes.assign(k > 0 ? k : 1, 0);
+            if (k > 0) {
+                nodes[0] = play(1, before);
+            }
+        }
+
+        /**
+         * @brief Returns the source whose head comes next.
+         */
+        size_t top() const { return nodes[0]; }
+
+        /**
+         * @brief Restores the winner after the head of top() changed.
+         * @param before Ordering predicate over source indices.
+         */
+        template<typename Before>
+        void replay(Before before) {
+            size_t winner = nodes[0];
+            for (size_t node = (winner + k) / 2; node > 0; node /= 2) {
+                if (before(nodes[node], winner)) {
+                    const size_t loser = winner;
+                    winner = nodes[node];
+                    nodes[node] = loser;
+                }
+            }
+            nodes[0] = winner;
+        }
+
+        /**
+         * @brief Returns the number of sources.
+         */
+        size_t sources() const { return k; }
+    };
+}
+
+#endif // LOSERTREE_H
@@ -0,0 +1,49 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef ORDERMAPPING_H
+#define ORDERMAPPING_H
+
+#include <cstddef>
+
+namespace Container {
+    /**
+     * @brief Names the traversal orders for APIs that take the order as a parameter.
+     */
+    enum class Traversal {
+        Insertion,
+        Ascending,
+        Descending,
+        SideCross,
+        Reverse,
+        MiddleOut
+    };
+
+    /**
+     * @brief Ascending rank of the element at position r of the side-cross order.
+     *
+     * Side-cross takes the smallest and largest remaining elements in turn:
+     * 0, n-1, 1, n-2, ...
+     * @param r Position in the side-cross order, below n.
+     * @param n Number of elements.
+     */
+    constexpr size_t side_cross_rank(size_t r, size_t n) noexcept {
+        return (r % 2 == 0) ? r / 2 : n - 1 - r / 2;
+    }
+
+    /**
+     * @brief Insertion rank of the element at position r of the middle-out order.
+     *
+     * Middle-out starts at n / 2 and then alternates one step left, one step right:
+     * mid, mid-1, mid+1, mid-2, ... Both sides run out on the same step, because the left
+     * side has n / 2 elements and the right side has n / 2 or n / 2 - 1 of them.
+     * @param r Position in the middle-out order, below n.
+     * @param n Number of elements.
+     */
+    constexpr size_t middle_out_rank(size_t r, size_t n) noexcept {
+        const size_t mid = n / 2;
+        if (r == 0) return mid;
+        return (r % 2 == 1) ? mid - (r + 1) / 2 : mid + r / 2;
+    }
+}
+
+#endif // ORDERMAPPING_H
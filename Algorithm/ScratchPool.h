@@ -0,0 +1,186 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef SCRATCHPOOL_H
+#define SCRATCHPOOL_H
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+namespace Container {
+
+    /**
+     * @brief Per-thread counters of the scratch-buffer pool.
+     *
+     * A hit is a lease served by a retained buffer that was already large enough,
+     * a miss is a lease that had to allocate or grow.
+     */
+    struct ScratchPoolStats {
+        size_t hits = 0;
+        size_t misses = 0;
+
+        double hitRate() const {
+            const size_t total = hits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+    };
+
+    /**
+     * @brief Returns the scratch-pool counters of the calling thread.
+     */
+    inline ScratchPoolStats &scratchPoolStats() {
+        static thread_local ScratchPoolStats stats;
+        return stats;
+    }
+
+    /**
+     * @brief Thread-local free list of std::vector<U> buffers kept with their capacity.
+     *
+     * Sort scratch, counting-sort histograms and iterator permutation buffers lease
+     * from here, so once a thread has warmed up, rebuilding an order allocates nothing.
+     */
+    template<typename U>
+    class ScratchPool {
+    public:
+        // Buffers retained per thread and element type; extra returns are freed
+        static constexpr size_t MAX_RETAINED = 8;
+
+        /**
+         * @brief Takes a buffer of n value-initialized elements from the pool.
+         *
+         * Prefers the smallest retained buffer that fits, otherwise the largest one,
+         * which then grows.
+         */
+        static std::vector<U> acquire(size_t n) {
+            std::vector<std::vector<U>> &retained = freeList();
+            std::vector<U> buffer;
+            if (!retained.empty()) {
+                size_t pick = 0;
+                for (size_t i = 1; i < retained.size(); ++i) {
+                    const size_t cap = retained[i].capacity();
+                    const size_t best = retained[pick].capacity();
+                    if (best < n ? cap > best : (cap >= n && cap < best)) {
+                        pick = i;
+                    }
+                }
+                buffer = std::move(retained[pick]);
+                retained[pick] = std::move(retained.back());
+                retained.pop_back();
+            }
+            ScratchPoolStats &stats = scratchPoolStats();
+            if (buffer.capacity() >= n) {
+                ++stats.hits;
+            } else {
+                ++stats.misses;
+            }
+            buffer.resize(n);
+            return buffer;
+        }
+
+        /**
+         * @brief Returns a buffer to the calling thread's pool.
+         */
+        static void release(std::vector<U> &&buffer) {
+            std::vector<std::vector<U>> &retained = freeList();
+            if (buffer.capacity() == 0 || retained.size() >= MAX_RETAINED) return;
+            buffer.clear();
+            retained.push_back(std::move(buffer));
+        }
+
+        /**
+         * @brief Frees every buffer retained by the calling thread.
+         */
+        static void trim() {
+            std::vector<std::vector<U>>().swap(freeList());
+        }
+
+    private:
+        static std::vector<std::vector<U>> &freeList() {
+            static thread_local std::vector<std::vector<U>> retained;
+            return retained;
+        }
+    };
+
+    /**
+     * @brief RAII lease of a pooled buffer with the subset of the std::vector interface
+     *        the sort kernels and iterators use. The buffer goes back to the pool of the
+     *        destroying thread.
+     */
+    template<typename U>
+    class ScratchBuffer {
+    private:
+        std::vector<U> buffer;
+
+    public:
+        using value_type = U;
+        using allocator_type = std::allocator<U>;
+        using iterator = typename std::vector<U>::iterator;
+        using const_iterator = typename std::vector<U>::const_iterator;
+
+        ScratchBuffer() = default;
+
+        /**
+         * @brief Leases a buffer of n elements; an empty buffer does not touch the pool.
+         */
+        explicit ScratchBuffer(size_t n) : buffer(n > 0 ? ScratchPool<U>::acquire(n) : std::vector<U>()) {}
+
+        ScratchBuffer(const ScratchBuffer &other) : ScratchBuffer(other.size()) {
+            std::copy(other.begin(), other.end(), buffer.begin());
+        }
+
+        ScratchBuffer(ScratchBuffer &&other) noexcept : buffer(std::move(other.buffer)) {}
+
+        ScratchBuffer &operator=(const ScratchBuffer &other) {
+            buffer.assign(other.begin(), other.end());
+            return *this;
+        }
+
+        ScratchBuffer &operator=(ScratchBuffer &&other) noexcept {
+            buffer.swap(other.buffer);
+            return *this;
+        }
+
+        ~ScratchBuffer() {
+            ScratchPool<U>::release(std::move(buffer));
+        }
+
+        allocator_type get_allocator() const { return allocator_type(); }
+
+        size_t size() const { return buffer.size(); }
+        bool empty() const { return buffer.empty(); }
+        void clear() { buffer.clear(); }
+        void reserve(size_t n) { buffer.reserve(n); }
+        void resize(size_t n) { buffer.resize(n); }
+        void push_back(const U &value) { buffer.push_back(value); }
+
+        U &operator[](size_t i) { return buffer[i]; }
+        const U &operator[](size_t i) const { return buffer[i]; }
+        U *data() { return buffer.data(); }
+        const U *data() const { return buffer.data(); }
+
+        iterator begin() { return buffer.begin(); }
+        iterator end() { return buffer.end(); }
+        const_iterator begin() const { return buffer.begin(); }
+        const_iterator end() const { return buffer.end(); }
+    };
+
+    /**
+     * @brief Scratch buffer matching the allocator of an existing buffer.
+     *
+     * Default-allocated containers lease from the thread-local pool; containers with a
+     * custom allocator (e.g. a pmr arena) keep their scratch on that allocator.
+     */
+    template<typename U, typename Like>
+    auto make_scratch(const Like &like, size_t n) {
+        using Allocator = typename std::allocator_traits<typename Like::allocator_type>::template rebind_alloc<U>;
+        if constexpr (std::is_same_v<Allocator, std::allocator<U>>) {
+            return ScratchBuffer<U>(n);
+        } else {
+            return std::vector<U, Allocator>(n, U(), Allocator(like.get_allocator()));
+        }
+    }
+}
+
+#endif // SCRATCHPOOL_H
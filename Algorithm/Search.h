@@ -0,0 +1,258 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CONTAINER_HAS_AVX2_DISPATCH 1
+#include <immintrin.h>
+#else
+#define CONTAINER_HAS_AVX2_DISPATCH 0
+#endif
+
+namespace Container {
+
+#if CONTAINER_HAS_AVX2_DISPATCH
+    namespace simd {
+        /**
+         * @brief Tells once per process whether the CPU runs AVX2 code.
+         */
+        inline bool has_avx2() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+            return supported;
+        }
+
+        /**
+         * @brief Shuffle table for mask compaction: row m lists, in order, the 32-bit lanes
+         *        whose bit is set in m, so one permute packs the kept lanes to the front.
+         */
+        struct CompactTable {
+            alignas(32) uint32_t lanes[256][8];
+
+            constexpr CompactTable() : lanes() {
+                for (uint32_t mask = 0; mask < 256; ++mask) {
+                    uint32_t out = 0;
+                    for (uint32_t lane = 0; lane < 8; ++lane) {
+                        if (mask & (1u << lane)) lanes[mask][out++] = lane;
+                    }
+                    for (; out < 8; ++out) lanes[mask][out] = 0;
+                }
+            }
+        };
+
+        inline constexpr CompactTable compactTable{};
+
+        // Lane policies: 8 x 32-bit integers, 8 floats or 4 doubles per 256-bit vector.
+        // match() returns one bit per element of the vector.
+        struct Int32Lanes {
+            using Scalar = int32_t;
+            using Vector = __m256i;
+            static constexpr size_t width = 8;
+
+            __attribute__((target("avx2"))) static Vector splat(Scalar v) { return _mm256_set1_epi32(v); }
+
+            __attribute__((target("avx2"))) static Vector load(const Scalar *p) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            }
+
+            __attribute__((target("avx2"))) static void store(Scalar *p, Vector v) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+            }
+
+            __attribute__((target("avx2"))) static Vector equal(Vector a, Vector b) { return _mm256_cmpeq_epi32(a, b); }
+
+            __attribute__((target("avx2"))) static Vector either(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+
+            __attribute__((target("avx2"))) static unsigned match(Vector eq) {
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+            }
+
+            // Row of the shuffle table for a mask of kept elements
+            __attribute__((target("avx2"))) static Vector pack(Vector v, unsigned keep) {
+                const __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i *>(compactTable.lanes[keep]));
+                return _mm256_permutevar8x32_epi32(v, lanes);
+            }
+        };
+
+        struct FloatLanes {
+            using Scalar = float;
+            using Vector = __m256;
+            static constexpr size_t width = 8;
+
+            __attribute__((target("avx2"))) static Vector splat(Scalar v) { return _mm256_set1_ps(v); }
+
+            __attribute__((target("avx2"))) static Vector load(const Scalar *p) { return _mm256_loadu_ps(p); }
+
+            __attribute__((target("avx2"))) static void store(Scalar *p, Vector v) { _mm256_storeu_ps(p, v); }
+
+            // Ordered, non-signalling equality: the same answer as operator== (NaN never matches)
+            __attribute__((target("avx2"))) static Vector equal(Vector a, Vector b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+
+            __attribute__((target("avx2"))) static Vector either(Vector a, Vector b) { return _mm256_or_ps(a, b); }
+
+            __attribute__((target("avx2"))) static unsigned match(Vector eq) {
+                return static_cast<unsigned>(_mm256_movemask_ps(eq));
+            }
+
+            __attribute__((target("avx2"))) static Vector pack(Vector v, unsigned keep) {
+                const __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i *>(compactTable.lanes[keep]));
+                return _mm256_permutevar8x32_ps(v, lanes);
+            }
+        };
+
+        struct DoubleLanes {
+            using Scalar = double;
+            using Vector = __m256d;
+            static constexpr size_t width = 4;
+
+            __attribute__((target("avx2"))) static Vector splat(Scalar v) { return _mm256_set1_pd(v); }
+
+            __attribute__((target("avx2"))) static Vector load(const Scalar *p) { return _mm256_loadu_pd(p); }
+
+            __attribute__((target("avx2"))) static void store(Scalar *p, Vector v) { _mm256_storeu_pd(p, v); }
+
+            __attribute__((target("avx2"))) static Vector equal(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+
+            __attribute__((target("avx2"))) static Vector either(Vector a, Vector b) { return _mm256_or_pd(a, b); }
+
+            __attribute__((target("avx2"))) static unsigned match(Vector eq) {
+                return static_cast<unsigned>(_mm256_movemask_pd(eq));
+            }
+
+            // A kept double is a pair of 32-bit lanes: spread each mask bit over two bits
+            __attribute__((target("avx2"))) static Vector pack(Vector v, unsigned keep) {
+                unsigned pairs = 0;
+                for (unsigned lane = 0; lane < 4; ++lane) {
+                    if (keep & (1u << lane)) pairs |= 3u << (2 * lane);
+                }
+                const __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i *>(compactTable.lanes[pairs]));
+                return _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), lanes));
+            }
+        };
+
+        /**
+         * @brief AVX2 search: four vectors per step are compared and OR-ed into one test,
+         *        then the step that matched is rescanned one vector at a time.
+         */
+        template<typename Lanes>
+        __attribute__((target("avx2")))
+        size_t find_avx2(const typename Lanes::Scalar *data, size_t n, typename Lanes::Scalar item) {
+            constexpr size_t w = Lanes::width;
+            const typename Lanes::Vector needle = Lanes::splat(item);
+            size_t i = 0;
+            for (; i + 4 * w <= n; i += 4 * w) {
+                const auto a = Lanes::equal(Lanes::load(data + i), needle);
+                const auto b = Lanes::equal(Lanes::load(data + i + w), needle);
+                const auto c = Lanes::equal(Lanes::load(data + i + 2 * w), needle);
+                const auto d = Lanes::equal(Lanes::load(data + i + 3 * w), needle);
+                if (Lanes::match(Lanes::either(Lanes::either(a, b), Lanes::either(c, d))) != 0) break;
+            }
+            for (; i + w <= n; i += w) {
+                const unsigned mask = Lanes::match(Lanes::equal(Lanes::load(data + i), needle));
+                if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+            }
+            for (; i < n; ++i) {
+                if (data[i] == item) return i;
+            }
+            return n;
+        }
+
+        /**
+         * @brief AVX2 compaction: each vector's non-matching elements are packed to the
+         *        front with one permute from the shuffle table and stored at the write cursor.
+         *
+         * The store covers a whole vector, but the write cursor never passes the read cursor,
+         * so it only overwrites elements that were already loaded.
+         */
+        template<typename Lanes>
+        __attribute__((target("avx2")))
+        size_t remove_avx2(typename Lanes::Scalar *data, size_t n, size_t first, typename Lanes::Scalar item) {
+            constexpr size_t w = Lanes::width;
+            constexpr unsigned all = (1u << w) - 1;
+            const typename Lanes::Vector needle = Lanes::splat(item);
+            size_t out = first;
+            size_t i = first;
+            for (; i + w <= n; i += w) {
+                const typename Lanes::Vector v = Lanes::load(data + i);
+                const unsigned keep = ~Lanes::match(Lanes::equal(v, needle)) & all;
+                if (keep == all) {
+                    Lanes::store(data + out, v);
+                    out += w;
+                } else if (keep != 0) {
+                    Lanes::store(data + out, Lanes::pack(v, keep));
+                    out += static_cast<size_t>(__builtin_popcount(keep));
+                }
+            }
+            for (; i < n; ++i) {
+                if (!(data[i] == item)) data[out++] = data[i];
+            }
+            return out;
+        }
+
+        /**
+         * @brief Lane policy for T: 32-bit integers, float and double have one, others void.
+         */
+        template<typename T>
+        using lanes_for = std::conditional_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) == 4, Int32Lanes,
+                          std::conditional_t<std::is_same_v<T, float>, FloatLanes,
+                          std::conditional_t<std::is_same_v<T, double>, DoubleLanes, void>>>;
+    }
+#endif
+
+    /**
+     * @brief Finds the first position holding item.
+     *
+     * For 32-bit integers, float and double on a CPU with AVX2 (checked once at run time)
+     * whole vectors are compared at a time; everything else goes through std::find.
+     *
+     * @param data Elements to search.
+     * @param n Number of elements.
+     * @param item Value to look for.
+     * @return Position of the first match, or n if there is none.
+     */
+    template<typename T>
+    size_t find_first(const T *data, size_t n, const T &item) {
+#if CONTAINER_HAS_AVX2_DISPATCH
+        using Lanes = simd::lanes_for<T>;
+        if constexpr (!std::is_void_v<Lanes>) {
+            if (simd::has_avx2()) {
+                using Scalar = typename Lanes::Scalar;
+                return simd::find_avx2<Lanes>(reinterpret_cast<const Scalar *>(data), n, static_cast<Scalar>(item));
+            }
+        }
+#endif
+        return static_cast<size_t>(std::find(data, data + n, item) - data);
+    }
+
+    /**
+     * @brief Removes every element equal to item, keeping the order of the rest.
+     *
+     * Uses AVX2 mask compaction under the same conditions as find_first, std::remove otherwise.
+     *
+     * @param data Elements to compact in place.
+     * @param n Number of elements.
+     * @param first Position of the first match (from find_first); elements before it are kept as is.
+     * @param item Value to remove.
+     * @return Number of elements left.
+     */
+    template<typename T>
+    size_t remove_all(T *data, size_t n, size_t first, const T &item) {
+#if CONTAINER_HAS_AVX2_DISPATCH
+        using Lanes = simd::lanes_for<T>;
+        if constexpr (!std::is_void_v<Lanes>) {
+            if (simd::has_avx2()) {
+                using Scalar = typename Lanes::Scalar;
+                return simd::remove_avx2<Lanes>(reinterpret_cast<Scalar *>(data), n, first, static_cast<Scalar>(item));
+            }
+        }
+#endif
+        return static_cast<size_t>(std::remove(data + first, data + n, item) - data);
+    }
+}
+
+#endif // SEARCH_H
@@ -0,0 +1,98 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef SORTINGNETWORK_H
+#define SORTINGNETWORK_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace Container {
+    /**
+     * @brief Largest key count sorted with a network; bigger inputs go to std::sort.
+     */
+    inline constexpr size_t sortingNetworkMaxSize = 16;
+
+    namespace network {
+        /**
+         * @brief One compare-exchange: afterwards keys[low] does not come after keys[high].
+         */
+        struct Comparator {
+            size_t low;
+            size_t high;
+        };
+
+        /**
+         * @brief Visits the comparators of Batcher's odd-even merge sort for n keys, in order.
+         *
+         * Sorted runs of p keys are merged pairwise, doubling p each round; for n up to 16
+         * that is at most 63 comparators.
+         */
+        template<typename Visit>
+        constexpr void batcher(size_t n, Visit &&visit) {
+            for (size_t p = 1; p < n; p *= 2) {
+                for (size_t k = p; k >= 1; k /= 2) {
+                    for (size_t j = k % p; j + k < n; j += 2 * k) {
+                        for (size_t i = 0; i < k && i + j + k < n; ++i) {
+                            if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                                visit(i + j, i + j + k);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        constexpr size_t comparatorCount(size_t n) {
+            size_t count = 0;
+            batcher(n, [&](size_t, size_t) { ++count; });
+            return count;
+        }
+
+        template<size_t N>
+        constexpr std::array<Comparator, comparatorCount(N)> makeComparators() {
+            std::array<Comparator, comparatorCount(N)> out{};
+            size_t next = 0;
+            batcher(N, [&](size_t low, size_t high) { out[next++] = Comparator{low, high}; });
+            return out;
+        }
+
+        /**
+         * @brief The network for N keys, computed once at compile time.
+         */
+        template<size_t N>
+        inline constexpr auto comparators = makeComparators<N>();
+
+        template<typename Key, typename Before>
+        constexpr void compareExchange(Key *keys, size_t low, size_t high, Before &before) {
+            if (before(keys[high], keys[low])) {
+                Key moved = std::move(keys[low]);
+                keys[low] = std::move(keys[high]);
+                keys[high] = std::move(moved);
+            }
+        }
+
+        template<size_t N, typename Key, typename Before, size_t... I>
+        constexpr void run([[maybe_unused]] Key *keys, [[maybe_unused]] Before &before, std::index_sequence<I...>) {
+            (compareExchange(keys, comparators<N>[I].low, comparators<N>[I].high, before), ...);
+        }
+    }
+
+    /**
+     * @brief Sorts exactly N keys with a fixed sequence of compare-exchanges.
+     *
+     * The comparator positions are constants, so the whole network unrolls into straight-line
+     * code with no loop or recursion, and it runs in constant expressions. The network is not
+     * stable: before must be a strict total order (break ties explicitly) for a unique result.
+     *
+     * @tparam N Number of keys.
+     * @param keys Keys to sort in place.
+     * @param before Strict ordering of two keys.
+     */
+    template<size_t N, typename Key, typename Before>
+    constexpr void network_sort(Key *keys, Before before) {
+        network::run<N>(keys, before, std::make_index_sequence<network::comparators<N>.size()>{});
+    }
+}
+
+#endif // SORTINGNETWORK_H
@@ -0,0 +1,345 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+namespace Container {
+    /**
+     * @brief Work-stealing thread pool shared by the parallel container operations.
+     *
+     * Every worker owns a deque: it pushes and pops its own tasks at the back (newest first,
+     * still warm in its cache) and, when it runs dry, steals the oldest task from the front
+     * of another worker's deque. Tasks submitted from outside the pool are spread over the
+     * deques round-robin. Idle workers sleep on a condition variable, so an unused pool
+     * costs nothing but its threads.
+     *
+     * A thread waiting in parallel_for runs queued tasks itself instead of blocking, so
+     * parallel operations can be nested (e.g. a parallel sort inside a parallel shard pass)
+     * without deadlocking the pool. Once nothing is left to take it sleeps until its last
+     * range finishes, instead of spinning while other threads run it.
+     *
+     * The library's parallel paths use shared(); its size can be set once at startup with
+     * configureShared().
+     */
+    class WorkStealingPool {
+    public:
+        using Task = std::function<void()>;
+
+    private:
+        // Padded to a cache line so the owner and thieves of different deques do not collide
+        struct alignas(64) WorkQueue {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        // Completion state of one parallel_for call
+        struct RangeGroup {
+            std::atomic<size_t> remaining;
+            std::exception_ptr error;
+            std::mutex lock;
+            std::condition_variable finished;
+
+            explicit RangeGroup(size_t ranges) : remaining(ranges) {}
+        };
+
+        std::vector<std::thread> workers;
+        std::unique_ptr<WorkQueue[]> queues;
+        size_t queueCount;
+
+        std::mutex sleepLock;
+        std::condition_variable wakeUp;
+        std::atomic<size_t> queued{0};
+        std::atomic<size_t> nextQueue{0};
+        std::atomic<size_t> stolen{0};
+        std::atomic<size_t> executed{0};
+        bool stopping = false;
+
+        static WorkStealingPool *&currentPool() {
+            thread_local WorkStealingPool *pool = nullptr;
+            return pool;
+        }
+
+        static size_t &currentIndex() {
+            thread_local size_t index = 0;
+            return index;
+        }
+
+        static size_t &requestedSharedThreads() {
+            static size_t threads = std::max(1u, std::thread::hardware_concurrency());
+            return threads;
+        }
+
+        static std::atomic<bool> &sharedCreated() {
+            static std::atomic<bool> created{false};
+            return created;
+        }
+
+        static size_t claimSharedThreads() {
+            sharedCreated().store(true);
+            return requestedSharedThreads();
+        }
+
+        bool popOwn(size_t index, Task &task) {
+            WorkQueue &queue = queues[index];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (queue.tasks.empty()) return false;
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        /**
+         * @brief Takes the oldest task of the first non-empty deque after start.
+         * @param start Deque to begin the scan after (the caller's own one for a worker).
+         * @param counted Whether a success counts as a steal (false for threads outside the pool).
+         */
+        bool steal(size_t start, bool counted, Task &task) {
+            for (size_t i = 1; i <= queueCount; ++i) {
+                WorkQueue &victim = queues[(start + i) % queueCount];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (victim.tasks.empty()) continue;
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                if (counted) {
+                    stolen.fetch_add(1, std::memory_order_relaxed);
+                }
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Takes one queued task: from the caller's own deque first, otherwise by stealing.
+         */
+        bool take(Task &task) {
+            if (queueCount == 0) return false;
+            const bool inPool = currentPool() == this;
+            const size_t index = inPool ? currentIndex() : nextQueue.load(std::memory_order_relaxed) % queueCount;
+            if ((inPool && popOwn(index, task)) || steal(index, inPool, task)) {
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+
+        void execute(Task &task) {
+            task();
+            executed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void workerLoop(size_t index) {
+            currentPool() = this;
+            currentIndex() = index;
+            Task task;
+            while (true) {
+                if (take(task)) {
+                    execute(task);
+                    task = nullptr;
+                    continue;
+                }
+                std::unique_lock<std::mutex> guard(sleepLock);
+                wakeUp.wait(guard, [this]() { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+                if (stopping && queued.load(std::memory_order_relaxed) == 0) return;
+            }
+        }
+
+    public:
+        /**
+         * **\
+         * @param threads Number of worker threads; 0 runs every task on the calling thread.
+         */
+        explicit WorkStealingPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+            : queues(new WorkQueue[std::max<size_t>(threads, 1)]), queueCount(threads) {
+            workers.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this, i]() { workerLoop(i); });
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+        /**
+         * **\
+         * @brief Runs the tasks still queued, then joins the workers.
+         */
+        ~WorkStealingPool() {
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for (auto &worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * **\
+         * @brief Returns the pool used by the container library's parallel operations.
+         */
+        static WorkStealingPool &shared() {
+            static WorkStealingPool pool(claimSharedThreads());
+            return pool;
+        }
+
+        /**
+         * **\
+         * @brief Sets the worker count of shared(); call it before the first parallel operation.
+         * @param threads Number of worker threads.
+         * @return false if the shared pool already exists (its size is then left unchanged).
+         */
+        static bool configureShared(size_t threads) {
+            if (sharedCreated().load()) return false;
+            requestedSharedThreads() = threads;
+            return true;
+        }
+
+        /**
+         * **\
+         * @brief Queues a task. From a worker of this pool it goes on that worker's own deque.
+         * @param task Callable run exactly once on some thread of the pool; it must not throw
+         *        (parallel_for catches and forwards exceptions itself).
+         */
+        void submit(Task task) {
+            if (queueCount == 0) {
+                task();
+                executed.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            const size_t index = currentPool() == this
+                                     ? currentIndex()
+                                     : nextQueue.fetch_add(1, std::memory_order_relaxed) % queueCount;
+            // Counted before it is visible, so a taker never drives the count below zero
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                queued.fetch_add(1, std::memory_order_relaxed);
+            }
+            {
+                std::lock_guard<std::mutex> guard(queues[index].lock);
+                queues[index].tasks.push_back(std::move(task));
+            }
+            wakeUp.notify_one();
+        }
+
+        /**
+         * **\
+         * @brief Runs body(lo, hi) over [begin, end) split into ranges of grain indices, and waits.
+         *
+         * body is called exactly once per range [begin + k * grain, min(end, begin + (k + 1) * grain)),
+         * so it can rely on every range starting at a multiple of grain and holding at most grain
+         * indices. The calling thread takes the first range and then helps with queued tasks until
+         * all ranges are done; a pool without workers runs the ranges in order on the calling thread.
+         * The first exception thrown by a range is rethrown here once every range has finished.
+         * @param begin First index.
+         * @param end One past the last index.
+         * @param grain Indices per task (at least 1).
+         * @param body Callable taking (size_t lo, size_t hi).
+         */
+        template<typename Body>
+        void parallel_for(size_t begin, size_t end, size_t grain, Body &&body) {
+            if (end <= begin) return;
+            grain = std::max<size_t>(grain, 1);
+            const size_t ranges = (end - begin + grain - 1) / grain;
+            if (ranges == 1) {
+                body(begin, end);
+                return;
+            }
+            if (queueCount == 0) {
+                std::exception_ptr error;
+                for (size_t r = 0; r < ranges; ++r) {
+                    const size_t lo = begin + r * grain;
+                    try {
+                        body(lo, std::min(end, lo + grain));
+                    } catch (...) {
+                        if (!error) error = std::current_exception();
+                    }
+                }
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+                return;
+            }
+
+            // Shared with the tasks: the last one to finish may still be notifying after
+            // the caller has woken up and returned
+            auto group = std::make_shared<RangeGroup>(ranges);
+            auto runRange = [&body, group](size_t lo, size_t hi) {
+                try {
+                    body(lo, hi);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(group->lock);
+                    if (!group->error) group->error = std::current_exception();
+                }
+                if (group->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> guard(group->lock);
+                    group->finished.notify_all();
+                }
+            };
+
+            // Queued last-to-first so the owner's LIFO pops and thieves' FIFO steals both
+            // start near the front of the range
+            for (size_t r = ranges - 1; r > 0; --r) {
+                const size_t lo = begin + r * grain;
+                submit([runRange, lo, hi = std::min(end, lo + grain)]() { runRange(lo, hi); });
+            }
+            runRange(begin, std::min(end, begin + grain));
+
+            Task task;
+            while (group->remaining.load(std::memory_order_acquire) > 0) {
+                if (take(task)) {
+                    execute(task);
+                    task = nullptr;
+                    continue;
+                }
+                // The rest of the ranges are running on other threads
+                std::unique_lock<std::mutex> guard(group->lock);
+                group->finished.wait(guard, [&group]() {
+                    return group->remaining.load(std::memory_order_acquire) == 0;
+                });
+            }
+            if (group->error) {
+                std::rethrow_exception(group->error);
+            }
+        }
+
+        /**
+         * **\
+         * @brief Returns the number of worker threads.
+         */
+        size_t threadCount() const { return workers.size(); }
+
+        /**
+         * **\
+         * @brief Returns the number of tasks queued and not yet started.
+         */
+        size_t queueDepth() const { return queued.load(std::memory_order_relaxed); }
+
+        /**
+         * **\
+         * @brief Returns how many tasks were taken from another worker's deque.
+         */
+        size_t stealCount() const { return stolen.load(std::memory_order_relaxed); }
+
+        /**
+         * **\
+         * @brief Returns how many tasks have run so far.
+         */
+        size_t executedCount() const { return executed.load(std::memory_order_relaxed); }
+    };
+}
+
+#endif // THREADPOOL_H
@@ -0,0 +1,244 @@
+//Email:Edenhassin@gmail.com
+
+// Sorted-order traversal with regular vs huge-page backed storage, and
+// multi-producer append throughput with a mutex vs the lock-free append path, and
+// sharded insert/sort/merged-scan times as the shard count grows, and
+// counting sort vs comparison sort around SortTuning::countingSortMinSize, and
+// the vector search/compaction kernels vs std::find / std::remove on 10^7 elements.
+// Usage: ./bench [element count]   (default 1 << 24)
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "MyContainer.h"
+#include "MultiProducerContainer.h"
+#include "ShardedContainer.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace Container;
+
+/**
+ * @brief Counts data-TLB read misses through perf_event_open when the kernel allows it.
+ */
+class TlbMissCounter {
+public:
+    TlbMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~TlbMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd < 0) return count;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+template<typename Storage>
+void runTraversal(const char *label, size_t count) {
+    MyContainer<int, Storage> container;
+    container.reserve(count);
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < count; ++i)
+        container.addElement(static_cast<int>(rng()));
+
+    // Build the cached permutation outside the measured region
+    auto it = container.begin_ascending_order();
+    auto end = container.end_ascending_order();
+
+    TlbMissCounter tlb;
+    long long sum = 0;
+    tlb.start();
+    auto begin = std::chrono::steady_clock::now();
+    for (; it != end; ++it)
+        sum += *it;
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    long long misses = tlb.stop();
+
+    std::cout << label << ": "
+              << std::chrono::duration<double, std::milli>(elapsed).count() << " ms, dTLB misses: ";
+    if (misses >= 0) std::cout << misses;
+    else std::cout << "n/a";
+    std::cout << " (checksum " << sum << ")" << std::endl;
+}
+
+template<typename Append>
+double appendSeconds(unsigned threads, size_t count, Append append) {
+    std::vector<std::thread> producers;
+    auto begin = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t]() {
+            for (size_t i = t; i < count; i += threads)
+                append(static_cast<int>(i));
+        });
+    }
+    for (auto &p : producers)
+        p.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void runAppendScaling(size_t count) {
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\nAppending " << count << " ints (million appends per second)" << std::endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        MyContainer<int, ChunkedStorage<int>> locked;
+        std::mutex lock;
+        const double lockedSeconds = appendSeconds(threads, count, [&](int v) {
+            std::lock_guard<std::mutex> guard(lock);
+            locked.addElement(v);
+        });
+
+        MultiProducerContainer<int> lockFree(count);
+        const double lockFreeSeconds = appendSeconds(threads, count, [&](int v) { lockFree.addElement(v); });
+
+        std::cout << threads << " producer(s): mutex " << count / lockedSeconds / 1e6
+                  << ", lock-free " << count / lockFreeSeconds / 1e6 << std::endl;
+    }
+}
+
+void runShardedScaling(size_t count) {
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\nSharded container with " << count << " ints (ms)" << std::endl;
+    for (unsigned shards = 1; shards <= maxThreads; shards *= 2) {
+        ShardedContainer<int> sharded(shards);
+        std::mt19937 rng(7);
+        std::vector<int> values(count);
+        for (int &v : values)
+            v = static_cast<int>(rng());
+
+        const double insertSeconds = appendSeconds(shards, count, [&](int i) { sharded.addElement(values[i]); });
+        auto begin = std::chrono::steady_clock::now();
+        sharded.prepareSortedOrder();
+        const double sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        begin = std::chrono::steady_clock::now();
+        long long checksum = 0;
+        for (auto it = sharded.begin_ascending_order(); it != sharded.end_ascending_order(); ++it)
+            checksum += *it;
+        const double scanMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        std::cout << shards << " shard(s): insert " << insertSeconds * 1e3 << ", sort " << sortMs
+                  << ", merged scan " << scanMs << " (checksum " << checksum << ")" << std::endl;
+    }
+}
+
+void runCountingSortCutoff(size_t count) {
+    std::cout << "\nSorted permutation of n ints spanning 4n keys (us per sort)" << std::endl;
+    const size_t savedMinSize = SortTuning::countingSortMinSize;
+    std::mt19937 rng(3);
+    std::vector<size_t> sorted;
+    for (size_t n = 16; n <= count; n *= 4) {
+        std::vector<int> values(n);
+        for (int &v : values)
+            v = static_cast<int>(rng() % (4 * n));
+
+        double micros[2];
+        for (int counting = 0; counting < 2; ++counting) {
+            SortTuning::countingSortMinSize = counting ? 0 : ~size_t(0);
+            const size_t reps = std::max<size_t>(1, (size_t(1) << 22) / n);
+            auto begin = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < reps; ++r)
+                build_sorted_indices(values, sorted);
+            micros[counting] = std::chrono::duration<double, std::micro>(
+                                   std::chrono::steady_clock::now() - begin).count() / static_cast<double>(reps);
+        }
+        std::cout << "n = " << n << ": comparison " << micros[0] << ", counting " << micros[1] << std::endl;
+    }
+    SortTuning::countingSortMinSize = savedMinSize;
+}
+
+template<typename T>
+void runSearchKernel(const char *label) {
+    constexpr size_t n = 10000000;
+    std::mt19937 rng(11);
+    std::vector<T> values(n);
+    for (T &v : values)
+        v = static_cast<T>(rng() % 1000);
+    // About 1% of the elements match the removed value
+    const T removed = static_cast<T>(7);
+    const T missing = static_cast<T>(-1);
+
+    auto millis = [](auto &&work) {
+        auto begin = std::chrono::steady_clock::now();
+        work();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    };
+    size_t found[2] = {0, 0};
+    const double stdFind = millis([&]() { found[0] = static_cast<size_t>(std::find(values.begin(), values.end(), missing) - values.begin()); });
+    const double kernelFind = millis([&]() { found[1] = find_first(values.data(), n, missing); });
+
+    std::vector<T> a = values;
+    std::vector<T> b = values;
+    size_t kept[2] = {0, 0};
+    const double stdRemove = millis([&]() { kept[0] = static_cast<size_t>(std::remove(a.begin(), a.end(), removed) - a.begin()); });
+    const double kernelRemove = millis([&]() { kept[1] = remove_all(b.data(), n, find_first(b.data(), n, removed), removed); });
+
+    std::cout << label << ": miss scan std::find " << stdFind << ", find_first " << kernelFind
+              << "; remove std::remove " << stdRemove << ", remove_all " << kernelRemove
+              << (found[0] == found[1] && kept[0] == kept[1] ? "" : "  MISMATCH") << std::endl;
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+    std::cout << "Ascending traversal of " << count << " random ints" << std::endl;
+
+    runTraversal<std::vector<int>>("std::allocator     ", count);
+    runTraversal<HugePageVector<int>>("HugePageAllocator  ", count);
+
+    std::cout << "explicit huge pages: " << hugePageStats().hugetlbMappings
+              << ", THP-advised mappings: " << hugePageStats().thpMappings << std::endl;
+
+    runAppendScaling(count);
+    runShardedScaling(count);
+    runCountingSortCutoff(count);
+
+    std::cout << "\nSearch and removal over 10^7 elements (ms)" << std::endl;
+    runSearchKernel<int>("int   ");
+    runSearchKernel<float>("float ");
+    runSearchKernel<double>("double");
+    return 0;
+}
@@ -0,0 +1,289 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef CONCURRENTCONTAINER_H
+#define CONCURRENTCONTAINER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+#include "MyContainer.h"
+
+namespace Container {
+    /**
+     * @brief Thread-safe MyContainer whose readers work on immutable snapshots.
+     *
+     * The current state is a shared_ptr<const MyContainer> published atomically. A reader
+     * takes a snapshot with one atomic load and can scan it in any order for as long as it
+     * likes; it never blocks and never sees a later write. A writer copies the current
+     * snapshot, applies its change, builds the sorted permutation, and only then publishes
+     * the copy, so readers never sort. Writers are serialized among themselves only.
+     *
+     * Every write copies the container (copy-on-write), so group many changes with update().
+     *
+     * With setBackgroundResort(true) a writer does not sort either: it records its copy as
+     * the latest state and returns, and a task on the shared WorkStealingPool sorts a copy
+     * of the newest state and publishes it. Readers keep the previous sorted snapshot until
+     * then. Back-to-back writes are coalesced into one sort.
+     *
+     * @tparam T Element type.
+     * @tparam Storage Storage policy of the snapshots.
+     */
+    template<typename T = int, typename Storage = std::vector<T>>
+    class ConcurrentContainer {
+    public:
+        using Snapshot = MyContainer<T, Storage>;
+        using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    private:
+#ifdef __cpp_lib_atomic_shared_ptr
+        std::atomic<SnapshotPtr> current;
+#else
+        SnapshotPtr current;
+#endif
+        std::atomic<uint64_t> publishedVersion{0};
+        std::mutex writeMutex;
+        std::mutex publishMutex;
+
+        // Guarded by writeMutex
+        uint64_t writtenVersion = 0;
+        std::shared_ptr<Snapshot> latest;   // newest written state while background resort is on
+        bool backgroundResort = false;
+        bool resortQueued = false;
+
+        std::mutex idleLock;
+        std::condition_variable idle;
+        size_t pendingResorts = 0;
+
+        SnapshotPtr load() const {
+#ifdef __cpp_lib_atomic_shared_ptr
+            return current.load(std::memory_order_acquire);
+#else
+            return std::atomic_load_explicit(&current, std::memory_order_acquire);
+#endif
+        }
+
+        /**
+         * @brief Publishes a sorted state unless a newer one is already visible.
+         * @param next Snapshot with its sorted order built.
+         * @param version Write count the snapshot reflects.
+         */
+        void publish(SnapshotPtr next, uint64_t version) {
+            std::lock_guard<std::mutex> guard(publishMutex);
+            if (version <= publishedVersion.load(std::memory_order_relaxed)) return;
+#ifdef __cpp_lib_atomic_shared_ptr
+            current.store(std::move(next), std::memory_order_release);
+#else
+            std::atomic_store_explicit(&current, std::move(next), std::memory_order_release);
+#endif
+            publishedVersion.store(version, std::memory_order_release);
+        }
+
+        /**
+         * @brief Sorts and publishes a written state, or hands it to a background resort.
+         * @param next State produced by a write.
+         * @param lock Held lock on writeMutex; released before a task is queued.
+         */
+        void commit(std::shared_ptr<Snapshot> next, std::unique_lock<std::mutex> &lock) {
+            const uint64_t version = ++writtenVersion;
+            if (!backgroundResort) {
+                latest.reset();
+                next->prepareSortedOrder();
+                publish(std::move(next), version);
+                return;
+            }
+            latest = std::move(next);
+            if (resortQueued) return;
+            resortQueued = true;
+            {
+                std::lock_guard<std::mutex> guard(idleLock);
+                ++pendingResorts;
+            }
+            lock.unlock();
+            WorkStealingPool::shared().submit([this]() { resortLatest(); });
+        }
+
+        /**
+         * @brief Background task: sorts a copy of the newest written state and publishes it.
+         */
+        void resortLatest() {
+            try {
+                std::shared_ptr<Snapshot> next;
+                uint64_t version;
+                {
+                    std::lock_guard<std::mutex> lock(writeMutex);
+                    // Writes from here on queue another task
+                    resortQueued = false;
+                    if (latest) {
+                        next = std::make_shared<Snapshot>(*latest);
+                    }
+                    version = writtenVersion;
+                }
+                if (next) {
+                    next->prepareSortedOrder();
+                    publish(std::move(next), version);
+                }
+            } catch (...) {
+                // Nothing is published; the next write queues a new resort
+            }
+            std::lock_guard<std::mutex> guard(idleLock);
+            --pendingResorts;
+            idle.notify_all();
+        }
+
+        /**
+         * @brief Copies the newest written state, applies change to the copy and commits it.
+         * @param lock Held lock on writeMutex.
+         */
+        template<typename Change>
+        auto updateLocked(Change &change, std::unique_lock<std::mutex> &lock) {
+            std::shared_ptr<Snapshot> next = std::make_shared<Snapshot>(latest ? *latest : *load());
+            if constexpr (std::is_void_v<decltype(change(*next))>) {
+                change(*next);
+                commit(std::move(next), lock);
+            } else {
+                auto result = change(*next);
+                commit(std::move(next), lock);
+                return result;
+            }
+        }
+
+        /**
+         * @brief Tells whether the newest written state holds item; writeMutex must be held.
+         */
+        bool writtenStateHolds(const T &item) const {
+            return latest ? latest->hasElement(item) : load()->hasElement(item);
+        }
+
+    public:
+        ConcurrentContainer() : current(std::make_shared<const Snapshot>()) {}
+
+        ConcurrentContainer(const ConcurrentContainer &) = delete;
+        ConcurrentContainer &operator=(const ConcurrentContainer &) = delete;
+
+        /**
+         * **\
+         * @brief Waits for background resorts still referring to this container.
+         */
+        ~ConcurrentContainer() {
+            waitForResort();
+        }
+
+        /**
+         * **\
+         * @brief Moves the sort after a write off the writing thread.
+         *
+         * When enabled, writes return without sorting and readers see them once a background
+         * resort publishes the sorted state; size() and version() lag until then. Turning it
+         * off waits for pending resorts and publishes any state they left unpublished.
+         * @param enabled Whether writes are sorted in the background.
+         */
+        void setBackgroundResort(bool enabled) {
+            {
+                std::lock_guard<std::mutex> lock(writeMutex);
+                backgroundResort = enabled;
+            }
+            if (enabled) return;
+            waitForResort();
+            std::lock_guard<std::mutex> lock(writeMutex);
+            if (latest && writtenVersion > publishedVersion.load(std::memory_order_acquire)) {
+                latest->prepareSortedOrder();
+                publish(std::move(latest), writtenVersion);
+            }
+            latest.reset();
+        }
+
+        /**
+         * **\
+         * @brief Blocks until every queued background resort has finished.
+         */
+        void waitForResort() {
+            std::unique_lock<std::mutex> guard(idleLock);
+            idle.wait(guard, [this]() { return pendingResorts == 0; });
+        }
+
+        /**
+         * **\
+         * @brief Returns the current state; it stays valid and unchanged while it is held.
+         * @return Immutable snapshot with its sorted order already built.
+         */
+        SnapshotPtr snapshot() const { return load(); }
+
+        /**
+         * **\
+         * @brief Applies a batch of changes to a private copy and publishes it once.
+         * @param change Callable taking Snapshot&; its return value is passed through.
+         *        If it throws, nothing is published.
+         */
+        template<typename Change>
+        auto update(Change &&change) {
+            std::unique_lock<std::mutex> lock(writeMutex);
+            return updateLocked(change, lock);
+        }
+
+        /**
+         * **\
+         * @brief Adds an element; readers see it from their next snapshot on.
+         * @param element Element to add.
+         */
+        void addElement(const T &element) {
+            update([&](Snapshot &c) { c.addElement(element); });
+        }
+
+        /**
+         * **\
+         * @brief Removes every occurrence of an element.
+         * @param item The element to remove.
+         * @throws std::runtime_error if the element is not found; nothing is published then.
+         */
+        void removeElement(const T &item) {
+            update([&](Snapshot &c) { c.removeElement(item); });
+        }
+
+        /**
+         * **\
+         * @brief Removes every occurrence of an element without throwing on a miss.
+         *
+         * A miss is detected on the current state: nothing is copied or published, and
+         * version() does not change.
+         * @return Number of elements removed.
+         */
+        size_t tryRemoveElement(const T &item) {
+            std::unique_lock<std::mutex> lock(writeMutex);
+            if (!writtenStateHolds(item)) return 0;
+            auto remove = [&](Snapshot &c) { return c.tryRemoveElement(item); };
+            return updateLocked(remove, lock);
+        }
+
+        /**
+         * **\
+         * @brief Removes only the first occurrence of an element.
+         *
+         * Like tryRemoveElement, a miss leaves the published state and version() untouched.
+         * @return true if an element was removed.
+         */
+        bool removeOne(const T &item) {
+            std::unique_lock<std::mutex> lock(writeMutex);
+            if (!writtenStateHolds(item)) return false;
+            auto remove = [&](Snapshot &c) { return c.removeOne(item); };
+            return updateLocked(remove, lock);
+        }
+
+        /**
+         * **\
+         * @brief Returns the number of elements in the current snapshot.
+         */
+        size_t size() const { return load()->size(); }
+
+        /**
+         * **\
+         * @brief Returns how many writes the current snapshot reflects.
+         */
+        uint64_t version() const { return publishedVersion.load(std::memory_order_acquire); }
+    };
+}
+
+#endif // CONCURRENTCONTAINER_H
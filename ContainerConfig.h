@@ -0,0 +1,31 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef CONTAINERCONFIG_H
+#define CONTAINERCONFIG_H
+
+/**
+ * @brief CONTAINER_CONSTEXPR marks functions that can run at compile time under C++20.
+ *
+ * StaticContainer, FixedVector and the order iterators rely on std::construct_at,
+ * constexpr destructors and constexpr std::sort, so they are only constexpr from
+ * C++20 on; with C++17 the macro expands to nothing.
+ */
+#if __cplusplus >= 202002L
+#define CONTAINER_HAS_CONSTEXPR 1
+#define CONTAINER_CONSTEXPR constexpr
+#else
+#define CONTAINER_HAS_CONSTEXPR 0
+#define CONTAINER_CONSTEXPR
+#endif
+
+/**
+ * @brief CONTAINER_HAS_COROUTINES is 1 when C++20 coroutines are available, enabling the
+ *        coroutine order generators and the awaitable sorted views.
+ */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define CONTAINER_HAS_COROUTINES 1
+#else
+#define CONTAINER_HAS_COROUTINES 0
+#endif
+
+#endif // CONTAINERCONFIG_H
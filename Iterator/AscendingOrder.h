@@ -5,9 +5,10 @@
 
 #include <vector>
 #include <algorithm>
+#include "../ContainerConfig.h"
 
 namespace Container {
-    template<typename T>
+    template<typename T, typename Storage>
     class MyContainer;
 
     /**
@@ -15,30 +16,24 @@ namespace Container {
     *
     * Iteration order is from the smallest element to the largest element
     * based on the values stored in the container.
+    *
+    * @tparam Owner Container being traversed (MyContainer with any storage policy, or StaticContainer).
     */
-    template<typename T = int>
+    template<typename T = int, typename Owner = MyContainer<T, std::vector<T>>>
     class AscendingIterator {
     private:
-        const MyContainer<T> &container;
+        const Owner &container;
         size_t index;
-        std::vector<size_t> sorted_indices;
+        const typename Owner::IndexBuffer *sorted_indices;
 
         /**
-         * @brief Helper function to build the sorted indices vector.
+         * @brief Helper function to attach the sorted indices vector.
          *
-         * Initializes sorted_indices with indices 0-size-1 and sorts them
-         * so that elements are in ascending order by their values.
+         * Points sorted_indices at the container's cached ascending permutation,
+         * which is only sorted again after the container changes.
          */
-        void build_ascending_order() {
-            const size_t s = container.size();
-            sorted_indices.resize(s);
-            for (size_t i = 0; i < s; ++i) {
-                sorted_indices[i] = i;
-            }
-            std::sort(sorted_indices.begin(), sorted_indices.end(),
-                      [&](size_t a, size_t b) {
-                          return container.elements[a] < container.elements[b];
-                      });
+        CONTAINER_CONSTEXPR void build_ascending_order() {
+            sorted_indices = &container.ascendingPositions();
         }
 
     public:
@@ -49,7 +44,7 @@ namespace Container {
          * @param cont Reference to the MyContainer to iterate.
          * @param start Starting index position (default is 0).
          */
-        explicit AscendingIterator(const MyContainer<T> &cont, size_t start = 0)
+        CONTAINER_CONSTEXPR explicit AscendingIterator(const Owner &cont, size_t start = 0)
             : container(cont), index(start) {
             build_ascending_order();
         }
@@ -60,11 +55,11 @@ namespace Container {
          * @return const T& Const reference to the current element.
          * @throws std::out_of_range if dereferencing beyond the end.
          */
-        const T &operator*() const {
-            if (index >= sorted_indices.size()) {
+        CONTAINER_CONSTEXPR const T &operator*() const {
+            if (index >= sorted_indices->size()) {
                 throw std::out_of_range("AscendingIterator: dereference out of range");
             }
-            return container.elements[sorted_indices[index]];
+            return container.elements[(*sorted_indices)[index]];
         }
 
         /**
@@ -73,8 +68,8 @@ namespace Container {
          * @return Reference to the incremented iterator.
          * @throws std::out_of_range if incrementing past the end.
          */
-        AscendingIterator &operator++() {
-            if (index >= sorted_indices.size()) {
+        CONTAINER_CONSTEXPR AscendingIterator &operator++() {
+            if (index >= sorted_indices->size()) {
                 throw std::out_of_range("AscendingIterator increment past end");
             }
             ++index;
@@ -86,7 +81,7 @@ namespace Container {
          *
          * @return A copy of the iterator before increment.
          */
-        AscendingIterator operator++(int) {
+        CONTAINER_CONSTEXPR AscendingIterator operator++(int) {
             AscendingIterator temp = *this;
             ++(*this);
             return temp;
@@ -100,7 +95,7 @@ namespace Container {
          * @param other Another AscendingIterator to compare.
          * @return true if equal, false otherwise.
          */
-        bool operator==(const AscendingIterator &other) const {
+        CONTAINER_CONSTEXPR bool operator==(const AscendingIterator &other) const {
             return &container == &other.container && index == other.index;
         }
 
@@ -110,7 +105,7 @@ namespace Container {
          * @param other Another AscendingIterator to compare.
          * @return true if not equal, false otherwise.
          */
-        bool operator!=(const AscendingIterator &other) const {
+        CONTAINER_CONSTEXPR bool operator!=(const AscendingIterator &other) const {
             return !(*this == other);
         }
     };
@@ -5,40 +5,34 @@
 
 #include <vector>
 #include <algorithm>
+#include "../ContainerConfig.h"
 
 namespace Container {
-    template<typename T> class MyContainer;
+    template<typename T, typename Storage> class MyContainer;
 
     /**
      * @brief Iterator that traverses a MyContainer in descending order.
      *
      * Iteration order is from the largest element to the smallest element
      * based on the values stored in the container.
+     *
+     * @tparam Owner Container being traversed (MyContainer with any storage policy, or StaticContainer).
      */
-    template<typename T = int>
+    template<typename T = int, typename Owner = MyContainer<T, std::vector<T>>>
     class DescendingIterator {
     private:
-        const MyContainer<T>& container;
+        const Owner& container;
         size_t index;
-        std::vector<size_t> sorted_indices;
+        const typename Owner::IndexBuffer *sorted_indices;
 
         /**
-         * @brief Builds the vector of indices sorted by descending order of element values.
+         * @brief Attaches the vector of indices sorted by element value.
          *
-         * Initializes sorted_indices with all element indices,
-         * then sorts them so that elements with higher values come first.
+         * Uses the container's cached ascending permutation and walks it from the back,
+         * so that elements with higher values come first.
          */
-        void build_descending_order() {
-            const size_t s = container.size();
-            sorted_indices.resize(s);
-            for (size_t i = 0; i < s; ++i) {
-                sorted_indices[i] = i;
-            }
-
-            std::sort(sorted_indices.begin(), sorted_indices.end(),
-                      [&](size_t a, size_t b) {
-                          return container.elements[a] > container.elements[b];
-                      });
+        CONTAINER_CONSTEXPR void build_descending_order() {
+            sorted_indices = &container.ascendingPositions();
         }
 
     public:
@@ -48,7 +42,7 @@ namespace Container {
          * @param cont Reference to the container to iterate.
          * @param start Starting position in the iteration (default is 0).
          */
-        explicit DescendingIterator(const MyContainer<T>& cont, size_t start = 0)
+        CONTAINER_CONSTEXPR explicit DescendingIterator(const Owner& cont, size_t start = 0)
             : container(cont), index(start) {
             build_descending_order();
         }
@@ -59,11 +53,11 @@ namespace Container {
          * @return Const reference to the current element in descending order.
          * @throws std::out_of_range if the iterator is out of bounds.
          */
-        const T& operator*() const {
-            if (index >= sorted_indices.size()) {
+        CONTAINER_CONSTEXPR const T& operator*() const {
+            if (index >= sorted_indices->size()) {
                 throw std::out_of_range("DescendingIterator: dereference out of range");
             }
-            return container.elements[sorted_indices[index]];
+            return container.elements[(*sorted_indices)[sorted_indices->size() - 1 - index]];
         }
 
         /**
@@ -72,8 +66,8 @@ namespace Container {
          * @return Reference to the incremented iterator.
          * @throws std::out_of_range if increment moves beyond the end.
          */
-        DescendingIterator& operator++() {
-            if (index >= sorted_indices.size()) {
+        CONTAINER_CONSTEXPR DescendingIterator& operator++() {
+            if (index >= sorted_indices->size()) {
                 throw std::out_of_range("DescendingIterator increment out of range");
             }
             ++index;
@@ -85,7 +79,7 @@ namespace Container {
          *
          * @return Copy of the iterator before increment.
          */
-        DescendingIterator operator++(int) {
+        CONTAINER_CONSTEXPR DescendingIterator operator++(int) {
             DescendingIterator temp = *this;
             ++(*this);
             return temp;
@@ -97,7 +91,7 @@ namespace Container {
          * @param other Another DescendingIterator to compare with.
          * @return True if both iterators refer to the same container and position.
          */
-        bool operator==(const DescendingIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator==(const DescendingIterator& other) const {
             return &container == &other.container && index == other.index;
         }
 
@@ -107,7 +101,7 @@ namespace Container {
          * @param other Another DescendingIterator to compare with.
          * @return True if iterators refer to different containers or positions.
          */
-        bool operator!=(const DescendingIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator!=(const DescendingIterator& other) const {
             return !(*this == other);
         }
     };
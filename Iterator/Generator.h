@@ -0,0 +1,158 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "../ContainerConfig.h"
+
+#if CONTAINER_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+
+namespace Container {
+    /**
+     * @brief Lazily evaluated sequence produced by a coroutine, in the style of std::generator.
+     *
+     * The coroutine runs only while the consumer advances the iterator: each co_yield hands
+     * out a reference to an element and suspends until the next ++it. Elements are not
+     * copied, so the yielded objects must outlive the consumer's use of them (container
+     * elements do, as long as the container is not modified).
+     *
+     * @tparam T Element type; the sequence yields const T&.
+     */
+    template<typename T>
+    class Generator {
+    public:
+        struct promise_type {
+            const T *current = nullptr;
+            std::exception_ptr error;
+
+            Generator get_return_object() {
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(const T &value) noexcept {
+                current = &value;
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() { error = std::current_exception(); }
+
+            // co_await is not meaningful inside a generator
+            template<typename U>
+            std::suspend_never await_transform(U &&) = delete;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /**
+         * @brief Input iterator over the yielded elements; compares equal to end() once the
+         *        coroutine has returned.
+         */
+        class iterator {
+            Handle handle;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            iterator() = default;
+
+            explicit iterator(Handle h) : handle(h) {}
+
+            const T &operator*() const { return *handle.promise().current; }
+
+            const T *operator->() const { return handle.promise().current; }
+
+            /**
+             * @brief Resumes the coroutine up to its next co_yield.
+             * @throws Whatever the coroutine body threw.
+             */
+            iterator &operator++() {
+                handle.resume();
+                if (handle.done() && handle.promise().error) {
+                    std::rethrow_exception(handle.promise().error);
+                }
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            bool operator==(std::default_sentinel_t) const { return !handle || handle.done(); }
+
+            bool operator!=(std::default_sentinel_t end) const { return !(*this == end); }
+        };
+
+    private:
+        Handle handle;
+
+        explicit Generator(Handle h) : handle(h) {}
+
+    public:
+        Generator(Generator &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+        Generator &operator=(Generator &&other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+
+        Generator(const Generator &) = delete;
+        Generator &operator=(const Generator &) = delete;
+
+        ~Generator() {
+            if (handle) handle.destroy();
+        }
+
+        /**
+         * @brief Starts the coroutine and returns an iterator at its first element.
+         *
+         * A generator is single-pass: call begin() once.
+         * @throws Whatever the coroutine body threw before its first co_yield.
+         */
+        iterator begin() {
+            iterator it(handle);
+            ++it;
+            return it;
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+    };
+
+    /**
+     * @brief Pair of order iterators usable in a range-based for loop.
+     *
+     * @tparam Iterator Order iterator type, e.g. AscendingIterator.
+     */
+    template<typename Iterator>
+    class OrderView {
+        Iterator first;
+        Iterator last;
+
+    public:
+        OrderView(Iterator begin, Iterator end) : first(std::move(begin)), last(std::move(end)) {}
+
+        Iterator begin() const { return first; }
+
+        Iterator end() const { return last; }
+    };
+}
+
+#endif // CONTAINER_HAS_COROUTINES
+
+#endif // GENERATOR_H
@@ -0,0 +1,258 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef MERGEDORDER_H
+#define MERGEDORDER_H
+
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../Algorithm/LoserTree.h"
+
+namespace Container {
+    /**
+     * @brief Iterator that merges several sorted sequences into one sorted traversal.
+     *
+     * Each source is a [current, end) pair of iterators already sorted by Compare, e.g.
+     * the ascending iterators of several containers. A LoserTree picks the source whose
+     * head comes next, so every step costs O(log k) comparisons for k sources and nothing
+     * is copied. Equal elements come out in source order.
+     *
+     * @tparam T Element type.
+     * @tparam Cursor Iterator type of the sources.
+     * @tparam Compare Order the sources are sorted by (std::less<T> for ascending,
+     *         std::greater<T> for descending).
+     */
+    template<typename T, typename Cursor, typename Compare = std::less<T>>
+    class MergedIterator {
+    private:
+        struct Run {
+            Cursor current;
+            Cursor end;
+        };
+
+        std::vector<Run> runs;
+        LoserTree tree;
+        Compare compare;
+        size_t index;
+        size_t total;
+
+        /**
+         * @brief Tells whether the head of run a goes before the head of run b.
+         *
+         * Exhausted runs go last; ties go to the lower run index.
+         */
+        bool before(size_t a, size_t b) const {
+            if (runs[a].current == runs[a].end) return false;
+            if (runs[b].current == runs[b].end) return true;
+            if (compare(*runs[a].current, *runs[b].current)) return true;
+            if (compare(*runs[b].current, *runs[a].current)) return false;
+            return a < b;
+        }
+
+    public:
+        /**
+         * @brief Constructs an iterator at the first element of the merged sequence.
+         *
+         * @param sources [begin, end) iterator pairs, each sorted by Compare.
+         * @param size Total number of elements in all sources.
+         * @param cmp Comparison the sources are sorted by.
+         */
+        MergedIterator(std::vector<std::pair<Cursor, Cursor>> sources, size_t size, Compare cmp = Compare())
+            : compare(cmp), index(0), total(size) {
+            runs.reserve(sources.size());
+            for (auto &source : sources) {
+                runs.push_back(Run{std::move(source.first), std::move(source.second)});
+            }
+            tree.reset(runs.size(), [this](size_t a, size_t b) { return before(a, b); });
+        }
+
+        /**
+         * @brief Constructs the past-the-end iterator of a merged sequence.
+         *
+         * @param size Total number of elements in all sources.
+         */
+        explicit MergedIterator(size_t size) : index(size), total(size) {}
+
+        /**
+         * @brief Dereferences the iterator to access the current element.
+         *
+         * @return const T& Const reference to the current element.
+         * @throws std::out_of_range if dereferencing beyond the end.
+         */
+        const T &operator*() const {
+            if (index >= total) {
+                throw std::out_of_range("MergedIterator: dereference out of range");
+            }
+            return *runs[tree.top()].current;
+        }
+
+        /**
+         * @brief Pre-increment operator to advance the iterator.
+         *
+         * @return Reference to the incremented iterator.
+         * @throws std::out_of_range if incrementing past the end.
+         */
+        MergedIterator &operator++() {
+            if (index >= total) {
+                throw std::out_of_range("MergedIterator increment past end");
+            }
+            ++runs[tree.top()].current;
+            tree.replay([this](size_t a, size_t b) { return before(a, b); });
+            ++index;
+            return *this;
+        }
+
+        /**
+         * @brief Post-increment operator to advance the iterator.
+         *
+         * @return A copy of the iterator before increment.
+         */
+        MergedIterator operator++(int) {
+            MergedIterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief Equality comparison operator.
+         *
+         * Two iterators over the same merged sequence are equal if they are at the same index.
+         *
+         * @param other Another MergedIterator to compare.
+         * @return true if equal, false otherwise.
+         */
+        bool operator==(const MergedIterator &other) const {
+            return index == other.index && total == other.total;
+        }
+
+        /**
+         * @brief Inequality comparison operator.
+         *
+         * @param other Another MergedIterator to compare.
+         * @return true if not equal, false otherwise.
+         */
+        bool operator!=(const MergedIterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Range over a merged sequence, for use in range-based for loops.
+     *
+     * @tparam Iterator MergedIterator type.
+     */
+    template<typename Iterator>
+    class MergedView {
+        Iterator first;
+        Iterator last;
+        size_t count;
+
+    public:
+        MergedView(Iterator begin, size_t size) : first(std::move(begin)), last(size), count(size) {}
+
+        Iterator begin() const { return first; }
+
+        Iterator end() const { return last; }
+
+        size_t size() const { return count; }
+    };
+
+    /**
+     * **\
+     * @brief Merges the ascending orders of several containers into one ascending view.
+     *
+     * Each container contributes its cached sorted permutation (built now if needed) and a
+     * loser tree interleaves them, so the global order costs O(N log k) for k containers
+     * without copying or re-sorting the elements. The view is valid while the containers
+     * are not modified.
+     * @param containers Containers of one type (MyContainer or StaticContainer).
+     * @return View whose iteration yields every element of every container in ascending order.
+     */
+    template<typename Owner>
+    auto merged_ascending(const std::vector<const Owner *> &containers) {
+        using Cursor = decltype(std::declval<const Owner &>().begin_ascending_order());
+        using T = std::decay_t<decltype(*std::declval<const Cursor &>())>;
+        using Iterator = MergedIterator<T, Cursor, std::less<T>>;
+        std::vector<std::pair<Cursor, Cursor>> runs;
+        runs.reserve(containers.size());
+        size_t total = 0;
+        for (const Owner *container : containers) {
+            runs.emplace_back(container->begin_ascending_order(), container->end_ascending_order());
+            total += container->size();
+        }
+        return MergedView<Iterator>(Iterator(std::move(runs), total), total);
+    }
+
+    /**
+     * **\
+     * @brief Merges the descending orders of several containers into one descending view.
+     * @param containers Containers of one type (MyContainer or StaticContainer).
+     * @return View whose iteration yields every element of every container in descending order.
+     */
+    template<typename Owner>
+    auto merged_descending(const std::vector<const Owner *> &containers) {
+        using Cursor = decltype(std::declval<const Owner &>().begin_descending_order());
+        using T = std::decay_t<decltype(*std::declval<const Cursor &>())>;
+        using Iterator = MergedIterator<T, Cursor, std::greater<T>>;
+        std::vector<std::pair<Cursor, Cursor>> runs;
+        runs.reserve(containers.size());
+        size_t total = 0;
+        for (const Owner *container : containers) {
+            runs.emplace_back(container->begin_descending_order(), container->end_descending_order());
+            total += container->size();
+        }
+        return MergedView<Iterator>(Iterator(std::move(runs), total), total);
+    }
+
+    /**
+     * **\
+     * @brief Merged ascending view over a vector of containers, e.g. one per partition.
+     */
+    template<typename Owner>
+    auto merged_ascending(const std::vector<Owner> &containers) {
+        std::vector<const Owner *> sources;
+        sources.reserve(containers.size());
+        for (const Owner &container : containers) {
+            sources.push_back(&container);
+        }
+        return merged_ascending(sources);
+    }
+
+    /**
+     * **\
+     * @brief Merged descending view over a vector of containers.
+     */
+    template<typename Owner>
+    auto merged_descending(const std::vector<Owner> &containers) {
+        std::vector<const Owner *> sources;
+        sources.reserve(containers.size());
+        for (const Owner &container : containers) {
+            sources.push_back(&container);
+        }
+        return merged_descending(sources);
+    }
+
+    /**
+     * **\
+     * @brief Merged ascending view over containers passed one by one: merged_ascending(a, b, c).
+     */
+    template<typename Owner, typename... Rest>
+    auto merged_ascending(const Owner &first, const Rest &... rest) {
+        static_assert((std::is_same_v<Owner, Rest> && ...), "merged_ascending needs containers of one type");
+        return merged_ascending(std::vector<const Owner *>{&first, &rest...});
+    }
+
+    /**
+     * **\
+     * @brief Merged descending view over containers passed one by one: merged_descending(a, b, c).
+     */
+    template<typename Owner, typename... Rest>
+    auto merged_descending(const Owner &first, const Rest &... rest) {
+        static_assert((std::is_same_v<Owner, Rest> && ...), "merged_descending needs containers of one type");
+        return merged_descending(std::vector<const Owner *>{&first, &rest...});
+    }
+}
+
+#endif // MERGEDORDER_H
@@ -4,10 +4,12 @@
 #define MIDDLEOUTORDER_H
 
 #include <vector>
+#include "../ContainerConfig.h"
+#include "../Algorithm/OrderMapping.h"
 
 
 namespace Container {
-    template<typename T> class MyContainer;
+    template<typename T, typename Storage> class MyContainer;
 
     /**
      * @brief Iterator that scans a MyContainer in middle-out order.
@@ -15,43 +17,33 @@ namespace Container {
      * Starts from the middle element, then alternates left and right.
      * For even-sized containers, the middle index is rounded down.
      * Example: For [7,15,6,1,2], the iteration order is 6,15,1,7,2.
+     *
+     * @tparam Owner Container being traversed (MyContainer with any storage policy, or StaticContainer).
      */
-    template<typename T = int>
+    template<typename T = int, typename Owner = MyContainer<T, std::vector<T>>>
     class MiddleOutIterator {
     private:
-        const MyContainer<T>& container;
+        const Owner& container;
         size_t index;
-        std::vector<size_t> middleOut_indices;
+        size_t count;
+        bool mapped = false;
+        typename Owner::ScratchIndexBuffer live_positions;
 
         /**
-         * @brief Builds the vector of indices in middle-out order.
+         * @brief Prepares the rank-to-position mapping of the middle-out order.
          *
-         * The order starts at the middle element, then alternates left and right.
+         * Position i of the order is insertion rank middle_out_rank(i, n), computed when the
+         * element is read, so no permutation is built. Only lazily removed slots need a
+         * table, mapping ranks among the live elements to storage positions.
          */
-        void build_middleOut_order() {
-            const size_t s = container.size();
-            middleOut_indices.clear();
-            if (s == 0) return;
-
-            const size_t mid = s / 2;  // round down if even
-
-            middleOut_indices.push_back(mid);
-
-            int left = static_cast<int>(mid) - 1;
-            size_t right = mid + 1;
-            bool nextIsLeft = true;
-
-            while (middleOut_indices.size() < s) {
-                if (nextIsLeft && left >= 0) {
-                    middleOut_indices.push_back(static_cast<size_t>(left));
-                    --left;
-                } else if (!nextIsLeft && right < s) {
-                    middleOut_indices.push_back(right);
-                    ++right;
-                }
-                nextIsLeft = !nextIsLeft;
+        CONTAINER_CONSTEXPR void build_middleOut_order() {
+            if (container.elements.size() == count) return;
+            live_positions = container.makeScratchBuffer(count);
+            for (size_t rank = 0; rank < count; ++rank) {
+                live_positions[rank] = rank;
             }
-
+            container.ranksToPositions(live_positions);
+            mapped = true;
         }
 
     public:
@@ -61,9 +53,12 @@ namespace Container {
          * @param cont Reference to the container to iterate.
          * @param start Initial index position within the computed middle-out order (default is 0).
          */
-        explicit MiddleOutIterator(const MyContainer<T>& cont, const size_t start = 0)
-            : container(cont), index(start) {
-            build_middleOut_order();
+        CONTAINER_CONSTEXPR explicit MiddleOutIterator(const Owner& cont, const size_t start = 0)
+            : container(cont), index(start), count(cont.size()), live_positions(cont.makeScratchBuffer(0)) {
+            // An end iterator is only compared by position, so it skips building the order
+            if (start < cont.size()) {
+                build_middleOut_order();
+            }
         }
 
         /**
@@ -72,11 +67,12 @@ namespace Container {
          * @return A const reference to the current element in the container.
          * @throws std::out_of_range if the iterator is out of bounds.
          */
-        const T& operator*() const {
-            if (index >= middleOut_indices.size()) {
+        CONTAINER_CONSTEXPR const T& operator*() const {
+            if (index >= count) {
                 throw std::out_of_range("MiddleOutIterator dereference out of range");
             }
-            return container.elements[middleOut_indices[index]];
+            const size_t rank = middle_out_rank(index, count);
+            return container.elements[mapped ? live_positions[rank] : rank];
         }
 
         /**
@@ -85,8 +81,8 @@ namespace Container {
          * @return Reference to the incremented iterator.
          * @throws std::out_of_range if incrementing beyond the range.
          */
-        MiddleOutIterator& operator++() {
-            if (index >= middleOut_indices.size()) {
+        CONTAINER_CONSTEXPR MiddleOutIterator& operator++() {
+            if (index >= count) {
                 throw std::out_of_range("MiddleOutIterator increment out of range");
             }
             ++index;
@@ -98,7 +94,7 @@ namespace Container {
          *
          * @return Copy of the iterator before the increment.
          */
-        MiddleOutIterator operator++(int) {
+        CONTAINER_CONSTEXPR MiddleOutIterator operator++(int) {
             MiddleOutIterator temp = *this;
             ++(*this);
             return temp;
@@ -110,7 +106,7 @@ namespace Container {
          * @param other Iterator to compare with.
          * @return True if both iterators point to the same position in the same container.
          */
-        bool operator==(const MiddleOutIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator==(const MiddleOutIterator& other) const {
             return &container == &other.container && index == other.index;
         }
 
@@ -120,7 +116,7 @@ namespace Container {
          * @param other Iterator to compare with.
          * @return True if the iterators point to different positions or containers.
          */
-        bool operator!=(const MiddleOutIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator!=(const MiddleOutIterator& other) const {
             return !(*this == other);
         }
     };
@@ -4,38 +4,53 @@
 #define ORDERITERATOR_H
 
 #include <cstddef>
+#include <vector>
 #include <stdexcept>
+#include "../ContainerConfig.h"
 
 namespace Container {
-    template<typename T> class MyContainer;
+    template<typename T, typename Storage> class MyContainer;
 
     /**
      * @brief Iterator that scans a MyContainer in original insertion order.
      *
      * The iteration goes in the exact order the elements were added to the container.
+     *
+     * @tparam Owner Container being traversed (MyContainer with any storage policy, or StaticContainer).
      */
-    template<typename T = int>
+    template<typename T = int, typename Owner = MyContainer<T, std::vector<T>>>
     class OrderIterator {
     private:
-        const MyContainer<T>& container;
+        const Owner& container;
         size_t index;
 
+        /**
+         * @brief Advances past lazily removed slots.
+         */
+        CONTAINER_CONSTEXPR void skip_removed() {
+            while (index < container.elements.size() && !container.isLive(index)) {
+                ++index;
+            }
+        }
+
     public:
         /**
          * @brief Constructs an OrderIterator for a given container.
          * @param cont Reference to the container to iterate over.
-         * @param start The starting index (default is 0).
+         * @param start The starting storage position (default is 0).
          */
-        explicit OrderIterator(const MyContainer<T>& cont, const size_t start = 0)
-            : container(cont), index(start) {}
+        CONTAINER_CONSTEXPR explicit OrderIterator(const Owner& cont, const size_t start = 0)
+            : container(cont), index(start) {
+            skip_removed();
+        }
 
         /**
          * @brief Dereference operator.
          * @return Reference to the element at the current iterator position.
          * @throws std::out_of_range if the iterator is out of bounds.
          */
-        const T& operator*() const {
-            if (index >= container.size()) {
+        CONTAINER_CONSTEXPR const T& operator*() const {
+            if (index >= container.elements.size()) {
                 throw std::out_of_range("OrderIterator: Dereferencing out of bounds");
             }
             return container.elements[index];
@@ -45,8 +60,9 @@ namespace Container {
          * @brief Prefix increment operator.
          * @return Reference to the incremented iterator.
          */
-        OrderIterator& operator++() {
+        CONTAINER_CONSTEXPR OrderIterator& operator++() {
             ++index;
+            skip_removed();
             return *this;
         }
 
@@ -54,7 +70,7 @@ namespace Container {
          * @brief Postfix increment operator.
          * @return A copy of the iterator before it was incremented.
          */
-        OrderIterator operator++(int) {
+        CONTAINER_CONSTEXPR OrderIterator operator++(int) {
             OrderIterator temp = *this;
             ++(*this);
             return temp;
@@ -65,7 +81,7 @@ namespace Container {
          * @param other Another iterator to compare with.
          * @return True if both iterators are at the same position in the same container.
          */
-        bool operator==(const OrderIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator==(const OrderIterator& other) const {
             return &container == &other.container && index == other.index;
         }
 
@@ -74,7 +90,7 @@ namespace Container {
          * @param other Another iterator to compare with.
          * @return True if the iterators are at different positions or containers.
          */
-        bool operator!=(const OrderIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator!=(const OrderIterator& other) const {
             return !(*this == other);
         }
     };
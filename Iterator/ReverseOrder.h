@@ -5,34 +5,40 @@
 
 #include <vector>
 #include <stdexcept>
+#include "../ContainerConfig.h"
 
 namespace Container {
-    template<typename T> class MyContainer;
+    template<typename T, typename Storage> class MyContainer;
 
     /**
      * @brief Iterator that scans a MyContainer in reverse order.
      *
      * The iteration goes from the last inserted element to the first.
      * For example, if the elements are [10, 20, 30], the iteration order will be 30, 20, 10.
+     *
+     * @tparam Owner Container being traversed (MyContainer with any storage policy, or StaticContainer).
      */
-    template<typename T = int>
+    template<typename T = int, typename Owner = MyContainer<T, std::vector<T>>>
     class ReverseIterator {
     private:
-        const MyContainer<T>& container;
+        const Owner& container;
         size_t index;
-        std::vector<size_t> reverse_indices;
+        typename Owner::ScratchIndexBuffer reverse_indices;
 
         /**
          * @brief Builds the vector of indices in reverse order.
          *
          * This function fills the reverse_indices vector with indices from
-         * the last to the first (i.e., size-1 down to 0).
+         * the last to the first (i.e., size-1 down to 0), skipping lazily removed slots.
          */
-        void build_reverse_order() {
-            const size_t s = container.size();
-            reverse_indices.resize(s);
-            for (size_t i = 0; i < s; ++i) {
-                reverse_indices[i] = s - 1 - i;
+        CONTAINER_CONSTEXPR void build_reverse_order() {
+            const size_t s = container.elements.size();
+            reverse_indices = container.makeScratchBuffer(container.size());
+            size_t out = 0;
+            for (size_t i = s; i > 0; --i) {
+                if (container.isLive(i - 1)) {
+                    reverse_indices[out++] = i - 1;
+                }
             }
         }
 
@@ -43,9 +49,12 @@ namespace Container {
          * @param cont Reference to the container to iterate
          * @param start Initial index (default is 0, which means start from the last element)
          */
-        explicit ReverseIterator(const MyContainer<T>& cont, size_t start = 0)
-            : container(cont), index(start) {
-            build_reverse_order();
+        CONTAINER_CONSTEXPR explicit ReverseIterator(const Owner& cont, size_t start = 0)
+            : container(cont), index(start), reverse_indices(cont.makeScratchBuffer(0)) {
+            // An end iterator is only compared by position, so it skips building the order
+            if (start < cont.size()) {
+                build_reverse_order();
+            }
         }
 
         /**
@@ -54,7 +63,7 @@ namespace Container {
          * @return Const reference to the current element.
          * @throws std::out_of_range if index is out of bounds.
          */
-        const T& operator*() const {
+        CONTAINER_CONSTEXPR const T& operator*() const {
             if (index >= reverse_indices.size()) {
                 throw std::out_of_range("ReverseIterator: Dereferencing out of bounds");
             }
@@ -67,7 +76,7 @@ namespace Container {
          *
          * @return Reference to the incremented iterator.
          */
-        ReverseIterator& operator++() {
+        CONTAINER_CONSTEXPR ReverseIterator& operator++() {
             ++index;
             return *this;
         }
@@ -77,7 +86,7 @@ namespace Container {
          *
          * @return Copy of the iterator before incrementing.
          */
-        ReverseIterator operator++(int) {
+        CONTAINER_CONSTEXPR ReverseIterator operator++(int) {
             ReverseIterator temp = *this;
             ++(*this);
             return temp;
@@ -89,7 +98,7 @@ namespace Container {
          * @param other Iterator to compare to.
          * @return True if both iterators point to the same container and index.
          */
-        bool operator==(const ReverseIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator==(const ReverseIterator& other) const {
             return &container == &other.container && index == other.index;
         }
 
@@ -99,7 +108,7 @@ namespace Container {
          * @param other Iterator to compare to.
          * @return True if iterators are not equal.
          */
-        bool operator!=(const ReverseIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator!=(const ReverseIterator& other) const {
             return !(*this == other);
         }
     };
@@ -6,9 +6,11 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include "../ContainerConfig.h"
+#include "../Algorithm/OrderMapping.h"
 
 namespace Container {
-    template<typename T> class MyContainer;
+    template<typename T, typename Storage> class MyContainer;
 
     /**
      * @brief Iterator that scans a MyContainer in side-cross order.
@@ -16,50 +18,25 @@ namespace Container {
      * The iteration order alternates between the smallest and largest remaining elements.
      * For example, for the sorted container [1, 2, 3, 4, 5], the iteration order will be:
      * 1, 5, 2, 4, 3
+     *
+     * @tparam Owner Container being traversed (MyContainer with any storage policy, or StaticContainer).
      */
 
-    template<typename T = int>
+    template<typename T = int, typename Owner = MyContainer<T, std::vector<T>>>
     class SideCrossIterator {
     private:
-        const MyContainer<T>& container;
+        const Owner& container;
         size_t index;
-        std::vector<size_t> sideCross_indices;
+        const typename Owner::IndexBuffer *sorted_indices = nullptr;
 
         /**
-         * @brief Builds the vector of indices in side-cross order.
+         * @brief Attaches the container's cached ascending permutation.
          *
-         * The method sorts the indices by the values they point to, and then
-         * alternates between taking the smallest and the largest remaining elements.
+         * No side-cross permutation is built: position i of the order is ascending rank
+         * side_cross_rank(i, n), computed when the element is read.
          */
-        void build_sideCross_order() {
-            const size_t s = container.size();
-            std::vector<size_t> sorted_indices(s);
-            for (size_t i = 0; i < s; ++i) {
-                sorted_indices[i] = i;
-            }
-
-            std::sort(sorted_indices.begin(), sorted_indices.end(),
-                [&](size_t a, size_t b) {
-                    return container.elements[a] < container.elements[b];
-                });
-
-            sideCross_indices.clear();
-            if (sorted_indices.empty()) return;
-
-            size_t left = 0;
-            size_t right = sorted_indices.size() - 1;
-
-            while (left <= right) {
-                if (left == right) {
-                    sideCross_indices.push_back(sorted_indices[left]);
-                } else {
-                    sideCross_indices.push_back(sorted_indices[left]);
-                    sideCross_indices.push_back(sorted_indices[right]);
-                }
-                left++;
-                if (right == 0) break;  // prevent underflow
-                right--;
-            }
+        CONTAINER_CONSTEXPR void build_sideCross_order() {
+            sorted_indices = &container.ascendingPositions();
         }
 
     public:
@@ -69,9 +46,12 @@ namespace Container {
          * @param cont Reference to the container.
          * @param start Starting index in the iteration order (default is 0).
          */
-        explicit SideCrossIterator(const MyContainer<T>& cont, const size_t start = 0)
+        CONTAINER_CONSTEXPR explicit SideCrossIterator(const Owner& cont, const size_t start = 0)
             : container(cont), index(start) {
-            build_sideCross_order();
+            // An end iterator is only compared by position, so it skips building the order
+            if (start < cont.size()) {
+                build_sideCross_order();
+            }
         }
 
         /**
@@ -80,11 +60,11 @@ namespace Container {
          * @return A const reference to the current element.
          * @throws std::out_of_range if the iterator is out of bounds.
          */
-        const T& operator*() const {
-            if (index >= sideCross_indices.size()) {
+        CONTAINER_CONSTEXPR const T& operator*() const {
+            if (sorted_indices == nullptr || index >= sorted_indices->size()) {
                 throw std::out_of_range("SideCrossIterator: Dereference past end");
             }
-            return container.elements[sideCross_indices[index]];
+            return container.elements[(*sorted_indices)[side_cross_rank(index, sorted_indices->size())]];
         }
 
         /**
@@ -93,7 +73,7 @@ namespace Container {
          * Advances the iterator to the next element.
          * @return Reference to the incremented iterator.
          */
-        SideCrossIterator& operator++() {
+        CONTAINER_CONSTEXPR SideCrossIterator& operator++() {
             ++index;
             return *this;
         }
@@ -103,7 +83,7 @@ namespace Container {
          *
          * @return Copy of the iterator before it was incremented.
          */
-        SideCrossIterator operator++(int) {
+        CONTAINER_CONSTEXPR SideCrossIterator operator++(int) {
             SideCrossIterator temp = *this;
             ++(*this);
             return temp;
@@ -115,7 +95,7 @@ namespace Container {
          * @param other Iterator to compare with.
          * @return True if iterators are equal.
          */
-        bool operator==(const SideCrossIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator==(const SideCrossIterator& other) const {
             return &container == &other.container && index == other.index;
         }
 
@@ -125,7 +105,7 @@ namespace Container {
          * @param other Iterator to compare with.
          * @return True if iterators are not equal.
          */
-        bool operator!=(const SideCrossIterator& other) const {
+        CONTAINER_CONSTEXPR bool operator!=(const SideCrossIterator& other) const {
             return !(*this == other);
         }
     };
@@ -0,0 +1,199 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef MULTIPRODUCERCONTAINER_H
+#define MULTIPRODUCERCONTAINER_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include "MyContainer.h"
+
+namespace Container {
+    /**
+     * @brief Append-only container that any number of threads can add to without locks.
+     *
+     * A producer reserves its slot with a compare-and-swap on the reservation counter,
+     * constructs the element in the slot's chunk and flags the slot as ready. The published size is a
+     * watermark that only moves over ready slots; whichever producer finds the next slots
+     * ready moves it, so no producer ever waits for another one.
+     *
+     * Readers see a consistent prefix: every element below size() is fully constructed and
+     * never changes. Insertion-order access works in place; snapshot() copies the prefix
+     * into a MyContainer for the sorted and other orders.
+     *
+     * Chunks are allocated on first use and installed in their directory slot with a
+     * compare-and-swap (a producer that loses the race frees its copy), so a large capacity
+     * costs only the directory until elements arrive. The chunk for a position is in place
+     * before that position is reserved: a failed allocation reserves nothing, and a reserved
+     * slot is always filled, so the watermark never stops at a hole.
+     *
+     * @tparam T Element type; moving it must not throw, so a reserved slot is always filled.
+     * @tparam ChunkSize Elements per chunk, a power of two.
+     */
+    template<typename T = int, size_t ChunkSize = 1024>
+    class MultiProducerContainer {
+        static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "Element moves must not throw");
+
+        struct Chunk {
+            alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+            std::atomic<bool> ready[ChunkSize] = {};
+
+            T *slot(size_t i) { return reinterpret_cast<T *>(storage) + i; }
+        };
+
+        const size_t limit;
+        const size_t maxChunks;
+        std::unique_ptr<std::atomic<Chunk *>[]> directory;
+        alignas(64) std::atomic<size_t> reserved{0};
+        alignas(64) std::atomic<size_t> published{0};
+
+        bool isReady(size_t pos) const {
+            const Chunk *chunk = directory[pos / ChunkSize].load(std::memory_order_acquire);
+            return chunk != nullptr && chunk->ready[pos % ChunkSize].load(std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief Returns chunk c, allocating and installing it if no producer has yet.
+         * @throws std::bad_alloc if the chunk cannot be allocated.
+         */
+        Chunk *chunkFor(size_t c) {
+            Chunk *chunk = directory[c].load(std::memory_order_acquire);
+            if (chunk != nullptr) {
+                return chunk;
+            }
+            Chunk *fresh = new Chunk;
+            if (directory[c].compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return fresh;
+            }
+            delete fresh;
+            return chunk;
+        }
+
+        /**
+         * @brief Moves the watermark over every consecutive ready slot.
+         */
+        void advanceWatermark() {
+            size_t mark = published.load(std::memory_order_acquire);
+            const size_t end = std::min(reserved.load(std::memory_order_acquire), limit);
+            while (mark < end && isReady(mark)) {
+                // On failure mark is reloaded, so another producer's progress is picked up
+                if (published.compare_exchange_weak(mark, mark + 1, std::memory_order_acq_rel)) {
+                    ++mark;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @param maxElements Upper bound on the number of elements ever added; only the chunk
+         *        directory is allocated here.
+         */
+        explicit MultiProducerContainer(size_t maxElements = size_t(1) << 24)
+            : limit(maxElements),
+              maxChunks((maxElements + ChunkSize - 1) / ChunkSize),
+              directory(new std::atomic<Chunk *>[maxChunks]()) {}
+
+        MultiProducerContainer(const MultiProducerContainer &) = delete;
+        MultiProducerContainer &operator=(const MultiProducerContainer &) = delete;
+
+        ~MultiProducerContainer() {
+            for (size_t c = 0; c < maxChunks; ++c) {
+                Chunk *chunk = directory[c].load(std::memory_order_relaxed);
+                if (chunk == nullptr) {
+                    continue;
+                }
+                for (size_t i = 0; i < ChunkSize; ++i) {
+                    if (chunk->ready[i].load(std::memory_order_relaxed)) {
+                        chunk->slot(i)->~T();
+                    }
+                }
+                delete chunk;
+            }
+        }
+
+        /**
+         * **\
+         * @brief Appends an element; safe to call from any number of threads at once.
+         *
+         * Lock-free: the slot's chunk is made present, then the slot is reserved with a
+         * compare-and-swap (retried, with the chunk rechecked, if another producer got there
+         * first), and the watermark update never waits for other producers. Only the first
+         * append into a chunk allocates.
+         * @param element Element to add (copied before the slot is reserved).
+         * @return Insertion index of the element.
+         * @throws std::length_error if maxElements has been reached.
+         * @throws std::bad_alloc if a new chunk cannot be allocated; nothing is reserved then.
+         */
+        size_t addElement(T element) {
+            size_t pos = reserved.load(std::memory_order_acquire);
+            Chunk *chunk;
+            do {
+                if (pos >= limit) {
+                    throw std::length_error("MultiProducerContainer: capacity exceeded");
+                }
+                chunk = chunkFor(pos / ChunkSize);
+            } while (!reserved.compare_exchange_weak(pos, pos + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+            ::new (static_cast<void *>(chunk->slot(pos % ChunkSize))) T(std::move(element));
+            chunk->ready[pos % ChunkSize].store(true, std::memory_order_seq_cst);
+            advanceWatermark();
+            return pos;
+        }
+
+        /**
+         * **\
+         * @brief Returns the published size: elements below it are complete and immutable.
+         */
+        size_t size() const { return published.load(std::memory_order_acquire); }
+
+        /**
+         * **\
+         * @brief Returns the maximum number of elements.
+         */
+        size_t capacity() const { return limit; }
+
+        /**
+         * **\
+         * @brief Accesses a published element.
+         * @param i Insertion index, below size().
+         */
+        const T &operator[](size_t i) const {
+            return *directory[i / ChunkSize].load(std::memory_order_acquire)->slot(i % ChunkSize);
+        }
+
+        /**
+         * **\
+         * @brief Copies the published prefix into a MyContainer with its sorted order built.
+         * @return Container holding the first size() elements in insertion order.
+         */
+        MyContainer<T> snapshot() const {
+            const size_t n = size();
+            MyContainer<T> copy;
+            copy.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                copy.addElement((*this)[i]);
+            }
+            copy.prepareSortedOrder();
+            return copy;
+        }
+
+        /**
+         * **\
+         * @brief Iterates the prefix published when the call is made, in insertion order.
+         */
+        template<typename Visitor>
+        void for_each_published(Visitor &&visit) const {
+            const size_t n = size();
+            for (size_t i = 0; i < n; ++i) {
+                visit((*this)[i]);
+            }
+        }
+    };
+}
+
+#endif // MULTIPRODUCERCONTAINER_H
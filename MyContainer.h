@@ -5,39 +5,349 @@
 #ifndef MYCONTAINER_H
 #define MYCONTAINER_H
 #include <vector>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <atomic>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <optional>
+#include <cstdint>
+#include "Algorithm/Sorting.h"
+#include "Algorithm/ScratchPool.h"
+#include "Algorithm/OrderMapping.h"
+#include "Algorithm/ThreadPool.h"
+#include "Algorithm/Search.h"
+#include "Storage/StorageTraits.h"
+#include "Storage/ChunkedStorage.h"
+#include "Storage/HugePageAllocator.h"
+#include "Storage/SmallVector.h"
 #include "Iterator/AscendingOrder.h"
 #include "Iterator/DescendingOrder.h"
 #include "Iterator/Order.h"
 #include "Iterator/SideCrossOrder.h"
 #include "Iterator/ReverseOrder.h"
 #include "Iterator/MiddleOutOrder.h"
+#include "Iterator/MergedOrder.h"
+#include "Iterator/Generator.h"
 
 namespace Container {
-    template<typename T = int>
+    /**
+     * @brief Generic container with several traversal orders.
+     *
+     * @tparam T Element type.
+     * @tparam Storage Element storage policy: std::vector<T> (contiguous, default),
+     *         ChunkedStorage<T> (fixed-size chunks, no bulk copies on growth) or
+     *         SmallVector<T, N> (first N elements inline, no heap for tiny containers). The storage's
+     *         allocator is rebound for every index buffer the container and its iterators
+     *         use, so std::pmr storage keeps all of them on the same memory resource.
+     *
+     * Const members, sorted scans included, may run on several threads at once: the cached
+     * ascending permutation they share is built under a lock by whichever of them needs it
+     * first, and the others wait for that build. Mutations are not synchronized and must not
+     * overlap any other call on the same container.
+     */
+    template<typename T = int, typename Storage = std::vector<T>>
     class MyContainer {
+        static_assert(std::is_same_v<typename Storage::value_type, T>, "Storage must hold elements of type T");
+
+    public:
+        using allocator_type = typename Storage::allocator_type;
+
+        template<typename U>
+        using RebindAllocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<U>;
+
+        using IndexBuffer = index_buffer_t<Storage, size_t>;
+
+        // Temporary index buffers: leased from the thread-local ScratchPool with the default
+        // allocator, allocated from the container's allocator otherwise.
+        using ScratchIndexBuffer = decltype(make_scratch<size_t>(std::declval<const IndexBuffer &>(), 0));
+
+        /**
+         * @brief Generational handle to one inserted element.
+         *
+         * A handle stays valid until its element is removed; after that the slot's
+         * generation moves on and the handle is reported as stale, even if the slot
+         * is reused. A default-constructed handle is never valid.
+         */
+        struct Handle {
+            size_t slot = 0;
+            uint32_t generation = 0;
+
+            bool operator==(const Handle &other) const { return slot == other.slot && generation == other.generation; }
+            bool operator!=(const Handle &other) const { return !(*this == other); }
+        };
+
     private:
-        std::vector<T> elements;
+        static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+        struct HandleSlot {
+            size_t position;       // storage position of the element, NO_SLOT while the slot is free
+            uint32_t generation;
+        };
+
+        Storage elements;
+
+        // Lazy removal: bit i of tombstones marks elements[i] as deleted until the next compaction
+        std::vector<uint64_t, RebindAllocator<uint64_t>> tombstones;
+        size_t deadCount = 0;
+        bool lazyRemoval = false;
+        double compactionThreshold = 0.25;
+
+        double growthFactor = 2.0;
+
+        // Handle tables, empty until the first handle is issued. slotOf[pos] is the handle
+        // slot of elements[pos] (or NO_SLOT); handleSlots[slot].position points back.
+        IndexBuffer slotOf;
+        std::vector<HandleSlot, RebindAllocator<HandleSlot>> handleSlots;
+        IndexBuffer freeHandleSlots;
+
+        // Ascending permutation of live storage positions, shared by the sorted-order iterators.
+        // It is rebuilt lazily after appends and bulk removals, edited in place by updateElement,
+        // filtered after tombstoning and remapped during compaction.
+        mutable IndexBuffer ascendingCache;
+        mutable bool ascendingValid = false;
+        mutable bool ascendingHasDead = false;
+
+        // Serializes builds of ascendingCache from const members. ready is set once the cache
+        // is valid and free of tombstones, so readers skip the lock; a copy gets its own lock
+        // and rechecks the copied cache on first use.
+        struct OrderCacheGuard {
+            std::mutex lock;
+            std::atomic<bool> ready{false};
+
+            OrderCacheGuard() = default;
+            OrderCacheGuard(const OrderCacheGuard &) {}
+            OrderCacheGuard &operator=(const OrderCacheGuard &) {
+                ready.store(false, std::memory_order_relaxed);
+                return *this;
+            }
+        };
+        mutable OrderCacheGuard orderGuard;
+
+        /**
+         * @brief Checks whether the slot at a storage position holds a live element.
+         * @param pos Position in elements.
+         * @return false if the slot was removed lazily and not compacted yet.
+         */
+        bool isLive(size_t pos) const {
+            return pos / 64 >= tombstones.size() || ((tombstones[pos / 64] >> (pos % 64)) & 1u) == 0;
+        }
+
+        void growIfFull();
+
+        void markDead(size_t pos);
+
+        void releaseSlot(size_t pos);
+
+        void compactIfNeeded();
+
+        size_t findLive(const T &item, size_t from) const;
+
+        size_t rankToPosition(size_t rank) const;
+
+        void updateAt(size_t pos, const T &value);
+
+        const IndexBuffer &ascendingPositions() const;
+
+        template<typename Values, typename Run>
+        void appendRun(const Values &values, const Run &run);
+
+        const size_t *prepareTraversal(Traversal order, ScratchIndexBuffer &live) const;
+
+        template<typename Visit>
+        void visitRanks(Traversal order, size_t lo, size_t hi, const size_t *live, Visit &visit) const;
+
+        /**
+         * @brief Drops the elements from storage position n onwards.
+         * @param n New number of stored slots.
+         */
+        void truncate(size_t n) {
+            if constexpr (is_contiguous_storage_v<Storage>) {
+                elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(n), elements.end());
+            } else {
+                while (elements.size() > n) {
+                    elements.pop_back();
+                }
+            }
+        }
+
+        /**
+         * @brief Creates a temporary index buffer of n elements.
+         * @return Pooled buffer, or a buffer on the container's allocator if it is a custom one.
+         */
+        ScratchIndexBuffer makeScratchBuffer(size_t n) const {
+            return make_scratch<size_t>(ascendingCache, n);
+        }
+
+        /**
+         * @brief Discards the cached ascending permutation; it is rebuilt on the next sorted scan.
+         */
+        void invalidateOrder() {
+            ascendingValid = false;
+            ascendingHasDead = false;
+            orderGuard.ready.store(false, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Removes tombstoned positions from a permutation, keeping the order of the rest.
+         * @param positions Permutation of storage positions.
+         */
+        template<typename Buffer>
+        void dropDead(Buffer &positions) const {
+            if (deadCount == 0) return;
+            positions.erase(std::remove_if(positions.begin(), positions.end(),
+                                           [&](size_t pos) { return !isLive(pos); }),
+                            positions.end());
+        }
+
+        /**
+         * @brief Maps ranks among the live elements (0..size()-1) to storage positions.
+         * @param ranks Ranks to translate in place.
+         */
+        template<typename Buffer>
+        void ranksToPositions(Buffer &ranks) const {
+            if (deadCount == 0) return;
+            ScratchIndexBuffer live = makeScratchBuffer(size());
+            size_t rank = 0;
+            for (size_t pos = 0; pos < elements.size(); ++pos) {
+                if (isLive(pos)) live[rank++] = pos;
+            }
+            for (size_t &r : ranks) {
+                r = live[r];
+            }
+        }
 
     public:
         // Give iterators access to private elements
-        friend class AscendingIterator<T>;
-        friend class DescendingIterator<T>;
-        friend class SideCrossIterator<T>;
-        friend class ReverseIterator<T>;
-        friend class OrderIterator<T>;
-        friend class MiddleOutIterator<T>;
+        friend class AscendingIterator<T, MyContainer>;
+        friend class DescendingIterator<T, MyContainer>;
+        friend class SideCrossIterator<T, MyContainer>;
+        friend class ReverseIterator<T, MyContainer>;
+        friend class OrderIterator<T, MyContainer>;
+        friend class MiddleOutIterator<T, MyContainer>;
+
+        class Writer;
+
+        MyContainer() : MyContainer(allocator_type()) {}
+
+        /**
+         * **\
+         * @brief Constructs an empty container whose storage and index buffers use an allocator.
+         *
+         * For std::pmr storage a std::pmr::memory_resource* converts to the allocator, e.g.
+         * pmr::MyContainer<int> c(&arena);
+         * @param alloc Allocator for elements, cached permutations and iterator buffers.
+         */
+        explicit MyContainer(const allocator_type &alloc)
+            : elements(alloc), tombstones(alloc), slotOf(alloc), handleSlots(alloc),
+              freeHandleSlots(alloc), ascendingCache(alloc) {}
+
+        /**
+         * **\
+         * @brief Returns the allocator of the element storage.
+         */
+        allocator_type get_allocator() const { return elements.get_allocator(); }
 
         void addElement(const T &element);
 
         void removeElement(const T &item);
 
+        size_t tryRemoveElement(const T &item);
+
+        bool removeOne(const T &item);
+
+        Handle addElementWithHandle(const T &element);
+
+        bool removeByHandle(Handle handle);
+
+        bool contains(Handle handle) const;
+
+        const T &get(Handle handle) const;
+
+        void updateElement(Handle handle, const T &value);
+
+        void updateElement(size_t index, const T &value);
+
+        void setLazyRemoval(bool enabled, double threshold = 0.25);
+
+        void compact();
+
+        void reserve(size_t n);
+
+        void shrink_to_fit();
+
+        void setGrowthFactor(double factor);
+
+        /**
+         * **\
+         * @brief Returns the number of element slots allocated, live or not.
+         * @return Capacity of the element storage.
+         */
+        size_t capacity() const { return elements.capacity(); }
+
         /**
          * **\
          * @brief Returns the number of elements currently stored.
          * @return Size of the container.
          */
-        size_t size() const { return elements.size(); }
+        size_t size() const { return elements.size() - deadCount; }
+
+        /**
+         * **\
+         * @brief Tells whether a live element equal to item is stored, without modifying anything.
+         * @param item Value to look for.
+         */
+        bool hasElement(const T &item) const { return findLive(item, 0) < elements.size(); }
+
+        /**
+         * **\
+         * @brief Returns the number of lazily removed slots awaiting compaction.
+         * @return Tombstone count.
+         */
+        size_t tombstoneCount() const { return deadCount; }
+
+        /**
+         * **\
+         * @brief Builds the cached ascending permutation now instead of on the next sorted scan.
+         *
+         * Afterwards sorted scans only read the container, so a container that is no longer
+         * modified can be scanned from several threads at once.
+         */
+        void prepareSortedOrder() const { ascendingPositions(); }
+
+        template<typename Function>
+        void parallel_for_each(Traversal order, Function f, size_t grain = 4096) const;
+
+        template<typename R, typename Reduce, typename Transform>
+        R parallel_transform_reduce(Traversal order, R init, Reduce reduce, Transform transform,
+                                    size_t grain = 4096) const;
+
+#if CONTAINER_HAS_COROUTINES
+        template<bool Descending>
+        class SortedOrderAwaiter;
+
+        Generator<T> generate(Traversal order) const;
+
+        /**
+         * **\
+         * @brief co_await container.ascending_async() sorts on the shared thread pool and
+         *        yields an OrderView of the ascending order.
+         *
+         * The awaiting coroutine resumes on a pool thread once the sorted order is built
+         * (immediately, without suspending, if it is already cached). Do not modify the
+         * container until the view is no longer used.
+         */
+        SortedOrderAwaiter<false> ascending_async() const { return SortedOrderAwaiter<false>(*this); }
+
+        /**
+         * **\
+         * @brief Like ascending_async(), yielding an OrderView of the descending order.
+         */
+        SortedOrderAwaiter<true> descending_async() const { return SortedOrderAwaiter<true>(*this); }
+#endif
 
         /**
      * ⚠️ Warning:
@@ -45,23 +355,23 @@ namespace Container {
      * Make sure to avoid modifying the container while iterating over it.
      */
 
-        AscendingIterator<T> begin_ascending_order() const { return AscendingIterator<T>(*this, 0); }
-        AscendingIterator<T> end_ascending_order() const { return AscendingIterator<T>(*this, size()); }
+        AscendingIterator<T, MyContainer> begin_ascending_order() const { return AscendingIterator<T, MyContainer>(*this, 0); }
+        AscendingIterator<T, MyContainer> end_ascending_order() const { return AscendingIterator<T, MyContainer>(*this, size()); }
 
-        DescendingIterator<T> begin_descending_order() const { return DescendingIterator<T>(*this, 0); }
-        DescendingIterator<T> end_descending_order() const { return DescendingIterator<T>(*this, size()); }
+        DescendingIterator<T, MyContainer> begin_descending_order() const { return DescendingIterator<T, MyContainer>(*this, 0); }
+        DescendingIterator<T, MyContainer> end_descending_order() const { return DescendingIterator<T, MyContainer>(*this, size()); }
 
-        SideCrossIterator<T> begin_side_cross_order() const { return SideCrossIterator<T>(*this, 0); }
-        SideCrossIterator<T> end_side_cross_order() const { return SideCrossIterator<T>(*this, size()); }
+        SideCrossIterator<T, MyContainer> begin_side_cross_order() const { return SideCrossIterator<T, MyContainer>(*this, 0); }
+        SideCrossIterator<T, MyContainer> end_side_cross_order() const { return SideCrossIterator<T, MyContainer>(*this, size()); }
 
-        ReverseIterator<T> begin_reverse_order() const { return ReverseIterator<T>(*this, 0); }
-        ReverseIterator<T> end_reverse_order() const { return ReverseIterator<T>(*this, size()); }
+        ReverseIterator<T, MyContainer> begin_reverse_order() const { return ReverseIterator<T, MyContainer>(*this, 0); }
+        ReverseIterator<T, MyContainer> end_reverse_order() const { return ReverseIterator<T, MyContainer>(*this, size()); }
 
-        OrderIterator<T> begin_order() const { return OrderIterator<T>(*this, 0); }
-        OrderIterator<T> end_order() const { return OrderIterator<T>(*this, size()); }
+        OrderIterator<T, MyContainer> begin_order() const { return OrderIterator<T, MyContainer>(*this, 0); }
+        OrderIterator<T, MyContainer> end_order() const { return OrderIterator<T, MyContainer>(*this, elements.size()); }
 
-        MiddleOutIterator<T> begin_middle_out_order() const { return MiddleOutIterator<T>(*this, 0); }
-        MiddleOutIterator<T> end_middle_out_order() const { return MiddleOutIterator<T>(*this, size()); }
+        MiddleOutIterator<T, MyContainer> begin_middle_out_order() const { return MiddleOutIterator<T, MyContainer>(*this, 0); }
+        MiddleOutIterator<T, MyContainer> end_middle_out_order() const { return MiddleOutIterator<T, MyContainer>(*this, size()); }
 
         /**
         * **\
@@ -70,13 +380,16 @@ namespace Container {
         * @param container Container to print.
         * @return Reference to the output stream.
         */
-        friend std::ostream &operator<<(std::ostream &os, const MyContainer<T> &container) {
+        friend std::ostream &operator<<(std::ostream &os, const MyContainer &container) {
             os << "[";
+            bool first = true;
             for (size_t i = 0; i < container.elements.size(); ++i) {
-                os << container.elements[i];
-                if (i + 1 != container.elements.size()) {
+                if (!container.isLive(i)) continue;
+                if (!first) {
                     os << ", ";
                 }
+                os << container.elements[i];
+                first = false;
             }
             os << "]";
             return os;
@@ -88,24 +401,840 @@ namespace Container {
      * @brief Adds an element to the container.
      * @param element Element to add.
      */
-    template<typename T>
-    void MyContainer<T>::addElement(const T &element) {
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::addElement(const T &element) {
+        invalidateOrder();
+        growIfFull();
         elements.push_back(element);
+        if (!slotOf.empty()) {
+            slotOf.push_back(NO_SLOT);
+        }
+    }
+
+    /**
+     * **\
+     * @brief Adds an element and returns a handle for O(1) access and removal.
+     * @param element Element to add.
+     * @return Handle identifying the new element.
+     */
+    template<typename T, typename Storage>
+    typename MyContainer<T, Storage>::Handle MyContainer<T, Storage>::addElementWithHandle(const T &element) {
+        if (slotOf.size() < elements.size()) {
+            slotOf.resize(elements.size(), NO_SLOT);
+        }
+        size_t slot;
+        if (freeHandleSlots.empty()) {
+            slot = handleSlots.size();
+            handleSlots.push_back(HandleSlot{NO_SLOT, 1});
+        } else {
+            slot = freeHandleSlots.back();
+            freeHandleSlots.pop_back();
+        }
+        handleSlots[slot].position = elements.size();
+        invalidateOrder();
+        growIfFull();
+        elements.push_back(element);
+        slotOf.push_back(slot);
+        return Handle{slot, handleSlots[slot].generation};
+    }
+
+    /**
+     * **\
+     * @brief Removes the element a handle refers to in O(1).
+     *
+     * The slot is tombstoned rather than erased; storage is compacted once the
+     * tombstone ratio crosses the compaction threshold.
+     * @param handle Handle returned by addElementWithHandle.
+     * @return true if the element was removed, false if the handle is stale.
+     */
+    template<typename T, typename Storage>
+    bool MyContainer<T, Storage>::removeByHandle(Handle handle) {
+        if (!contains(handle)) return false;
+        const size_t pos = handleSlots[handle.slot].position;
+        releaseSlot(pos);
+        markDead(pos);
+        compactIfNeeded();
+        return true;
+    }
+
+    /**
+     * **\
+     * @brief Checks whether a handle still refers to an element in the container.
+     * @param handle Handle to check.
+     * @return true if the handle is valid, false if it is stale.
+     */
+    template<typename T, typename Storage>
+    bool MyContainer<T, Storage>::contains(Handle handle) const {
+        return handle.slot < handleSlots.size()
+               && handleSlots[handle.slot].generation == handle.generation
+               && handleSlots[handle.slot].position != NO_SLOT;
+    }
+
+    /**
+     * **\
+     * @brief Accesses the element a handle refers to in O(1).
+     * @param handle Handle returned by addElementWithHandle.
+     * @return Const reference to the element.
+     * @throws std::out_of_range if the handle is stale.
+     */
+    template<typename T, typename Storage>
+    const T &MyContainer<T, Storage>::get(Handle handle) const {
+        if (!contains(handle)) {
+            throw std::out_of_range("MyContainer: stale handle");
+        }
+        return elements[handleSlots[handle.slot].position];
     }
 
     /**
          * **\
-         * @brief Removes an element from the container.
+         * @brief Removes every occurrence of an element from the container.
          * @param item The element to remove.
          * @throws std::runtime_error if the element is not found.
          */
-    template<typename T>
-    void MyContainer<T>::removeElement(const T &item) {
-        auto oldSize = elements.size();
-        elements.erase(std::remove(elements.begin(), elements.end(), item), elements.end());
-        if (elements.size() == oldSize) {
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::removeElement(const T &item) {
+        if (tryRemoveElement(item) == 0) {
             throw std::runtime_error("Element not found in container");
         }
     }
+
+    /**
+         * **\
+         * @brief Removes every occurrence of an element without throwing on a miss.
+         *
+         * Contiguous storage goes through the find_first / remove_all kernels in
+         * Algorithm/Search.h (AVX2 for 32-bit integers, float and double), so a miss costs
+         * only the search.
+         * @param item The element to remove.
+         * @return Number of elements removed (0 if the element is not found).
+         */
+    template<typename T, typename Storage>
+    size_t MyContainer<T, Storage>::tryRemoveElement(const T &item) {
+        if (lazyRemoval || !slotOf.empty()) {
+            size_t removed = 0;
+            for (size_t pos = findLive(item, 0); pos < elements.size(); pos = findLive(item, pos + 1)) {
+                releaseSlot(pos);
+                markDead(pos);
+                ++removed;
+            }
+            // With handles issued, eager removal still goes through compaction so that
+            // handle positions are fixed up in the same pass.
+            if (lazyRemoval) {
+                compactIfNeeded();
+            } else {
+                compact();
+            }
+            return removed;
+        }
+
+        compact();
+        const size_t n = elements.size();
+        if constexpr (is_contiguous_storage_v<Storage>) {
+            T *data = elements.data();
+            const size_t first = find_first(data, n, item);
+            if (first == n) return 0;
+            invalidateOrder();
+            truncate(remove_all(data, n, first, item));
+        } else {
+            const size_t first = findLive(item, 0);
+            if (first == n) return 0;
+            invalidateOrder();
+            size_t out = first;
+            for (size_t pos = first + 1; pos < n; ++pos) {
+                if (!(elements[pos] == item)) {
+                    elements[out++] = std::move(elements[pos]);
+                }
+            }
+            truncate(out);
+        }
+        return n - elements.size();
+    }
+
+    /**
+         * **\
+         * @brief Removes only the first occurrence of an element.
+         * @param item The element to remove.
+         * @return true if an element was removed, false if it was not found.
+         */
+    template<typename T, typename Storage>
+    bool MyContainer<T, Storage>::removeOne(const T &item) {
+        if (!lazyRemoval) {
+            compact();
+        }
+        const size_t pos = findLive(item, 0);
+        if (pos == elements.size()) return false;
+        if (!lazyRemoval && slotOf.empty()) {
+            invalidateOrder();
+            for (size_t next = pos + 1; next < elements.size(); ++next) {
+                elements[next - 1] = std::move(elements[next]);
+            }
+            elements.pop_back();
+            return true;
+        }
+        releaseSlot(pos);
+        markDead(pos);
+        if (lazyRemoval) {
+            compactIfNeeded();
+        } else {
+            compact();
+        }
+        return true;
+    }
+
+    /**
+     * **\
+     * @brief Switches between eager removal and lazy (tombstone) removal.
+     *
+     * In lazy mode a removal only marks the slot in a bitmap; iterators skip marked
+     * slots, and the storage is compacted in one pass once the share of tombstones
+     * exceeds the threshold. Turning lazy mode off compacts immediately.
+     * @param enabled true to enable lazy removal.
+     * @param threshold Tombstone ratio (of all slots) that triggers compaction.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::setLazyRemoval(bool enabled, double threshold) {
+        lazyRemoval = enabled;
+        compactionThreshold = threshold;
+        if (!enabled) {
+            compact();
+        }
+    }
+
+    /**
+     * **\
+     * @brief Drops all tombstoned slots, preserving the insertion order of live elements.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::compact() {
+        if (deadCount == 0) return;
+
+        // Remap the cached permutation in one pass: a live position moves down by the
+        // number of tombstones in front of it.
+        if (ascendingValid) {
+            ScratchIndexBuffer deadBefore = makeScratchBuffer(tombstones.size() + 1);
+            for (size_t w = 0; w < tombstones.size(); ++w) {
+                deadBefore[w + 1] = deadBefore[w] + static_cast<size_t>(__builtin_popcountll(tombstones[w]));
+            }
+            size_t kept = 0;
+            for (size_t pos : ascendingCache) {
+                if (!isLive(pos)) continue;
+                const size_t word = pos / 64;
+                size_t shift = deadBefore[std::min(word, tombstones.size())];
+                if (word < tombstones.size()) {
+                    const uint64_t below = (uint64_t(1) << (pos % 64)) - 1;
+                    shift += static_cast<size_t>(__builtin_popcountll(tombstones[word] & below));
+                }
+                ascendingCache[kept++] = pos - shift;
+            }
+            ascendingCache.resize(kept);
+            ascendingHasDead = false;
+        }
+
+        const bool tracked = !slotOf.empty();
+        size_t out = 0;
+        for (size_t pos = 0; pos < elements.size(); ++pos) {
+            if (!isLive(pos)) {
+                if (tracked) {
+                    releaseSlot(pos);
+                }
+                continue;
+            }
+            if (out != pos) {
+                elements[out] = std::move(elements[pos]);
+                if (tracked) {
+                    slotOf[out] = slotOf[pos];
+                    if (slotOf[out] != NO_SLOT) {
+                        handleSlots[slotOf[out]].position = out;
+                    }
+                }
+            }
+            ++out;
+        }
+        truncate(out);
+        if (tracked) {
+            slotOf.resize(out);
+        }
+        tombstones.clear();
+        deadCount = 0;
+    }
+
+    /**
+     * **\
+     * @brief Pre-allocates storage so that the next appends up to n elements do not reallocate.
+     * @param n Number of element slots to reserve.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::reserve(size_t n) {
+        elements.reserve(n);
+        if (!slotOf.empty()) {
+            slotOf.reserve(n);
+        }
+    }
+
+    /**
+     * **\
+     * @brief Compacts tombstones and releases unused capacity of the element storage and caches.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::shrink_to_fit() {
+        compact();
+        elements.shrink_to_fit();
+        slotOf.shrink_to_fit();
+        ascendingCache.shrink_to_fit();
+    }
+
+    /**
+     * **\
+     * @brief Sets the factor by which storage grows when an append finds it full.
+     *
+     * Only contiguous storage reallocates; chunked storage always grows one chunk at a time.
+     * @param factor Growth factor, greater than 1 (default 2).
+     * @throws std::invalid_argument if factor is not greater than 1.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::setGrowthFactor(double factor) {
+        if (!(factor > 1.0)) {
+            throw std::invalid_argument("MyContainer: growth factor must be greater than 1");
+        }
+        growthFactor = factor;
+    }
+
+    /**
+     * @brief Grows contiguous storage by the growth factor if the next append would not fit.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::growIfFull() {
+        if constexpr (!is_contiguous_storage_v<Storage>) return;
+        const size_t cap = elements.capacity();
+        if (elements.size() < cap) return;
+        const size_t grown = static_cast<size_t>(static_cast<double>(cap) * growthFactor);
+        elements.reserve(std::max(grown, cap + 1));
+    }
+
+    /**
+     * @brief Marks the slot at a storage position as removed.
+     * @param pos Position of a live element.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::markDead(size_t pos) {
+        if (pos / 64 >= tombstones.size()) {
+            tombstones.resize(elements.size() / 64 + 1, 0);
+        }
+        tombstones[pos / 64] |= uint64_t(1) << (pos % 64);
+        ++deadCount;
+        ascendingHasDead = ascendingValid;
+        orderGuard.ready.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Frees the handle slot of the element at a storage position, if it has one.
+     *
+     * Bumping the generation makes every outstanding handle to the slot stale.
+     * @param pos Storage position of the element.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::releaseSlot(size_t pos) {
+        if (pos >= slotOf.size() || slotOf[pos] == NO_SLOT) return;
+        HandleSlot &slot = handleSlots[slotOf[pos]];
+        slot.position = NO_SLOT;
+        ++slot.generation;
+        freeHandleSlots.push_back(slotOf[pos]);
+        slotOf[pos] = NO_SLOT;
+    }
+
+    /**
+     * @brief Compacts once the tombstone ratio crosses the configured threshold.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::compactIfNeeded() {
+        if (deadCount > 0 && static_cast<double>(deadCount) > compactionThreshold * static_cast<double>(elements.size())) {
+            compact();
+        }
+    }
+
+    /**
+     * @brief Finds the first live occurrence of an element at or after a storage position.
+     * @param item Value to look for.
+     * @param from First position to examine.
+     * @return Position of the match, or elements.size() if there is none.
+     */
+    template<typename T, typename Storage>
+    size_t MyContainer<T, Storage>::findLive(const T &item, size_t from) const {
+        const size_t n = elements.size();
+        while (from < n) {
+            size_t pos;
+            if constexpr (is_contiguous_storage_v<Storage>) {
+                pos = from + find_first(elements.data() + from, n - from, item);
+            } else {
+                pos = from;
+                while (pos < n && !(elements[pos] == item)) {
+                    ++pos;
+                }
+            }
+            if (pos == n || isLive(pos)) return pos;
+            from = pos + 1;
+        }
+        return n;
+    }
+
+    /**
+     * **\
+     * @brief Replaces the value of the element a handle refers to.
+     *
+     * A cached sorted order is repaired by moving the single affected entry instead of being rebuilt.
+     * @param handle Handle returned by addElementWithHandle.
+     * @param value New value.
+     * @throws std::out_of_range if the handle is stale.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::updateElement(Handle handle, const T &value) {
+        if (!contains(handle)) {
+            throw std::out_of_range("MyContainer: stale handle");
+        }
+        updateAt(handleSlots[handle.slot].position, value);
+    }
+
+    /**
+     * **\
+     * @brief Replaces the value of the element at an insertion-order index.
+     *
+     * A cached sorted order is repaired by moving the single affected entry instead of being rebuilt.
+     * @param index Index of the element in insertion order (0..size()-1).
+     * @param value New value.
+     * @throws std::out_of_range if index is not smaller than size().
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::updateElement(size_t index, const T &value) {
+        if (index >= size()) {
+            throw std::out_of_range("MyContainer: update index out of range");
+        }
+        updateAt(rankToPosition(index), value);
+    }
+
+    /**
+     * @brief Writes a new value at a storage position and moves its entry in the cached order.
+     *
+     * The old rank is found by binary search on the old value, the new rank by binary search
+     * on the new value, and the entries in between are shifted by one with a single rotate.
+     * @param pos Storage position of a live element.
+     * @param value New value.
+     */
+    template<typename T, typename Storage>
+    void MyContainer<T, Storage>::updateAt(size_t pos, const T &value) {
+        if (!ascendingValid) {
+            elements[pos] = value;
+            return;
+        }
+
+        auto byValue = [&](size_t p, const T &v) { return elements[p] < v; };
+        auto valueBefore = [&](const T &v, size_t p) { return v < elements[p]; };
+        const auto first = ascendingCache.begin();
+        const auto last = ascendingCache.end();
+
+        auto from = std::lower_bound(first, last, elements[pos], byValue);
+        while (from != last && *from != pos) {
+            ++from;
+        }
+        if (from == last) {
+            // Not in the cached order (e.g. a value that does not order against itself)
+            elements[pos] = value;
+            invalidateOrder();
+            return;
+        }
+
+        if (value < elements[pos]) {
+            auto to = std::upper_bound(first, from, value, valueBefore);
+            elements[pos] = value;
+            std::rotate(to, from, from + 1);
+        } else {
+            auto to = std::lower_bound(from + 1, last, value, byValue);
+            elements[pos] = value;
+            std::rotate(from, from + 1, to);
+        }
+    }
+
+    /**
+     * @brief Translates a rank among the live elements into a storage position.
+     *
+     * Skips whole bitmap words by popcount, so the cost is O(n / 64) with tombstones
+     * and O(1) without them.
+     * @param rank Insertion-order index of a live element.
+     * @return Its position in elements.
+     */
+    template<typename T, typename Storage>
+    size_t MyContainer<T, Storage>::rankToPosition(size_t rank) const {
+        if (deadCount == 0) return rank;
+        size_t word = 0;
+        for (; word < tombstones.size(); ++word) {
+            const size_t live = 64 - static_cast<size_t>(__builtin_popcountll(tombstones[word]));
+            if (rank < live) break;
+            rank -= live;
+        }
+        size_t pos = word * 64;
+        while (!isLive(pos) || rank > 0) {
+            if (isLive(pos)) --rank;
+            ++pos;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Returns the ascending permutation of live storage positions, building it if needed.
+     *
+     * Safe to call from several threads at once: the first caller builds the permutation
+     * under orderGuard and the others block until it is published.
+     * @return Cached permutation; valid until the next mutation.
+     */
+    template<typename T, typename Storage>
+    const typename MyContainer<T, Storage>::IndexBuffer &MyContainer<T, Storage>::ascendingPositions() const {
+        if (orderGuard.ready.load(std::memory_order_acquire)) {
+            return ascendingCache;
+        }
+        std::lock_guard<std::mutex> guard(orderGuard.lock);
+        if (!ascendingValid) {
+            build_sorted_indices(elements, ascendingCache);
+            ascendingValid = true;
+            ascendingHasDead = deadCount > 0;
+        }
+        if (ascendingHasDead) {
+            dropDead(ascendingCache);
+            ascendingHasDead = false;
+        }
+        orderGuard.ready.store(true, std::memory_order_release);
+        return ascendingCache;
+    }
+
+    /**
+     * @brief Appends a batch in insertion order and merges it into the cached sorted order.
+     *
+     * The cached permutation is extended by one backwards merge of the batch's sorted run,
+     * O(size() + batch) and without allocating, instead of being dropped and rebuilt by
+     * the next sorted scan.
+     * @param values Elements to append, in insertion order.
+     * @param run Indices into values in ascending order of value.
+     */
+    template<typename T, typename Storage>
+    template<typename Values, typename Run>
+    void MyContainer<T, Storage>::appendRun(const Values &values, const Run &run) {
+        const size_t base = elements.size();
+        for (const T &value : values) {
+            growIfFull();
+            elements.push_back(value);
+            if (!slotOf.empty()) {
+                slotOf.push_back(NO_SLOT);
+            }
+        }
+        if (!ascendingValid) return;
+
+        size_t old = ascendingCache.size();
+        size_t added = run.size();
+        ascendingCache.resize(old + added);
+        size_t out = old + added;
+        // Fill from the back; on ties the batch goes last, as its positions are larger
+        while (added > 0) {
+            if (old > 0 && elements[base + run[added - 1]] < elements[ascendingCache[old - 1]]) {
+                ascendingCache[--out] = ascendingCache[--old];
+            } else {
+                ascendingCache[--out] = base + run[--added];
+            }
+        }
+    }
+
+    /**
+     * @brief Per-thread buffered writer for a container shared between threads.
+     *
+     * addElement only appends to the writer's own buffer. Every batchSize elements the
+     * buffer is sorted on the writing thread and then handed over under the shared mutex,
+     * which is held just for the append and a linear merge into the cached sorted order.
+     * Readers of the container lock the same mutex.
+     *
+     * Usage: one Writer per producer thread, all constructed on the same container and mutex.
+     */
+    template<typename T, typename Storage>
+    class MyContainer<T, Storage>::Writer {
+        MyContainer &target;
+        std::mutex &lock;
+        size_t batchSize;
+        std::vector<T> pending;
+        std::vector<size_t> run;
+
+    public:
+        /**
+         * **\
+         * @param container Shared container the batches are written to.
+         * @param mutex Mutex guarding every access to container.
+         * @param batch Number of buffered elements that triggers a flush (at least 1).
+         */
+        Writer(MyContainer &container, std::mutex &mutex, size_t batch = 256)
+            : target(container), lock(mutex), batchSize(std::max<size_t>(batch, 1)) {
+            pending.reserve(batchSize);
+        }
+
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        /**
+         * **\
+         * @brief Flushes what is still buffered. Errors are swallowed here; call flush()
+         *        first to observe them.
+         */
+        ~Writer() {
+            try {
+                flush();
+            } catch (...) {
+            }
+        }
+
+        /**
+         * **\
+         * @brief Buffers an element; flushes the batch once it is full.
+         * @param element Element to add.
+         */
+        void addElement(const T &element) {
+            pending.push_back(element);
+            if (pending.size() >= batchSize) {
+                flush();
+            }
+        }
+
+        /**
+         * **\
+         * @brief Moves the buffered elements into the container under one short critical section.
+         */
+        void flush() {
+            if (pending.empty()) return;
+            build_sorted_indices(pending, run);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                target.appendRun(pending, run);
+            }
+            pending.clear();
+        }
+
+        /**
+         * **\
+         * @brief Returns the number of elements buffered but not yet visible in the container.
+         */
+        size_t pendingCount() const { return pending.size(); }
+    };
+
+    /**
+     * @brief Builds what a traversal needs before it is split over threads.
+     *
+     * Orders derived from the sorted order get the cached permutation built now, so the
+     * tasks only read it instead of queueing on its build lock. Orders over insertion ranks get
+     * a rank-to-position table when there are tombstones.
+     * @param order Traversal order.
+     * @param live Buffer that receives the table.
+     * @return The table, or nullptr when insertion ranks are storage positions.
+     */
+    template<typename T, typename Storage>
+    const size_t *MyContainer<T, Storage>::prepareTraversal(Traversal order, ScratchIndexBuffer &live) const {
+        if (order == Traversal::Ascending || order == Traversal::Descending || order == Traversal::SideCross) {
+            ascendingPositions();
+            return nullptr;
+        }
+        if (deadCount == 0) return nullptr;
+        live = makeScratchBuffer(size());
+        size_t rank = 0;
+        for (size_t pos = 0; pos < elements.size(); ++pos) {
+            if (isLive(pos)) live[rank++] = pos;
+        }
+        return live.data();
+    }
+
+    /**
+     * @brief Visits positions [lo, hi) of a traversal order.
+     *
+     * Every order maps its position to an element in O(1) (see Algorithm/OrderMapping.h),
+     * so any range can be visited without the positions before it.
+     * @param order Traversal order, prepared with prepareTraversal.
+     * @param lo First position in the order.
+     * @param hi One past the last position.
+     * @param live Rank-to-position table from prepareTraversal, or nullptr.
+     * @param visit Callable taking const T&.
+     */
+    template<typename T, typename Storage>
+    template<typename Visit>
+    void MyContainer<T, Storage>::visitRanks(Traversal order, size_t lo, size_t hi, const size_t *live,
+                                             Visit &visit) const {
+        const size_t n = size();
+        auto atRank = [&](size_t rank) -> const T & { return elements[live != nullptr ? live[rank] : rank]; };
+        switch (order) {
+            case Traversal::Insertion:
+                for (size_t r = lo; r < hi; ++r) visit(atRank(r));
+                break;
+            case Traversal::Reverse:
+                for (size_t r = lo; r < hi; ++r) visit(atRank(n - 1 - r));
+                break;
+            case Traversal::Ascending:
+                for (size_t r = lo; r < hi; ++r) visit(elements[ascendingCache[r]]);
+                break;
+            case Traversal::Descending:
+                for (size_t r = lo; r < hi; ++r) visit(elements[ascendingCache[n - 1 - r]]);
+                break;
+            case Traversal::SideCross:
+                for (size_t r = lo; r < hi; ++r) visit(elements[ascendingCache[side_cross_rank(r, n)]]);
+                break;
+            case Traversal::MiddleOut:
+                for (size_t r = lo; r < hi; ++r) visit(atRank(middle_out_rank(r, n)));
+                break;
+        }
+    }
+
+    /**
+     * **\
+     * @brief Calls f on every element, splitting the order into ranges run on the shared thread pool.
+     *
+     * Each range is visited in order, but ranges run concurrently, so f must be safe to call
+     * from several threads. The container must not be modified until the call returns.
+     * @param order Traversal order to split.
+     * @param f Callable taking const T&.
+     * @param grain Number of consecutive elements per task.
+     */
+    template<typename T, typename Storage>
+    template<typename Function>
+    void MyContainer<T, Storage>::parallel_for_each(Traversal order, Function f, size_t grain) const {
+        ScratchIndexBuffer live = makeScratchBuffer(0);
+        const size_t *table = prepareTraversal(order, live);
+        WorkStealingPool::shared().parallel_for(0, size(), grain, [&](size_t lo, size_t hi) {
+            visitRanks(order, lo, hi, table, f);
+        });
+    }
+
+    /**
+     * **\
+     * @brief Transforms every element and folds the results, in parallel over ranges of an order.
+     *
+     * Each range is folded on its own and the partial results are folded in order, so reduce
+     * needs to be associative but not commutative: the result equals
+     * reduce(...reduce(reduce(init, transform(e0)), transform(e1))..., transform(en-1))
+     * for the elements e0..en-1 in the given order.
+     * @param order Traversal order to split.
+     * @param init Initial value of the fold.
+     * @param reduce Callable (R, R) -> R.
+     * @param transform Callable (const T&) -> R; called from several threads.
+     * @param grain Number of consecutive elements per task.
+     * @return The folded value (init for an empty container).
+     */
+    template<typename T, typename Storage>
+    template<typename R, typename Reduce, typename Transform>
+    R MyContainer<T, Storage>::parallel_transform_reduce(Traversal order, R init, Reduce reduce, Transform transform,
+                                                         size_t grain) const {
+        ScratchIndexBuffer live = makeScratchBuffer(0);
+        const size_t *table = prepareTraversal(order, live);
+        const size_t n = size();
+        grain = std::max<size_t>(grain, 1);
+        std::vector<std::optional<R>> partials((n + grain - 1) / grain);
+        WorkStealingPool::shared().parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+            // Fold every grain-sized piece into its own partial, whatever range the pool hands out
+            for (size_t from = lo; from < hi; from = std::min(hi, from + grain)) {
+                std::optional<R> &partial = partials[from / grain];
+                auto fold = [&](const T &element) {
+                    if (partial) {
+                        partial = reduce(std::move(*partial), transform(element));
+                    } else {
+                        partial.emplace(transform(element));
+                    }
+                };
+                visitRanks(order, from, std::min(hi, from + grain), table, fold);
+            }
+        });
+        for (std::optional<R> &partial : partials) {
+            if (partial) {
+                init = reduce(std::move(init), std::move(*partial));
+            }
+        }
+        return init;
+    }
+
+#if CONTAINER_HAS_COROUTINES
+    /**
+     * **\
+     * @brief Streams the elements in a traversal order, one per resumption.
+     *
+     * Nothing happens until the first element is requested; then the order is prepared
+     * (the sorted permutation, or the rank table when there are tombstones) and each step
+     * maps one position in O(1). The container must not be modified while streaming.
+     * @param order Traversal order.
+     * @return Generator yielding const T& in that order.
+     */
+    template<typename T, typename Storage>
+    Generator<T> MyContainer<T, Storage>::generate(Traversal order) const {
+        ScratchIndexBuffer live = makeScratchBuffer(0);
+        const size_t *table = prepareTraversal(order, live);
+        const size_t n = size();
+        const T *element = nullptr;
+        auto grab = [&element](const T &e) { element = &e; };
+        for (size_t r = 0; r < n; ++r) {
+            visitRanks(order, r, r + 1, table, grab);
+            co_yield *element;
+        }
+    }
+
+    /**
+     * @brief Awaitable returned by ascending_async() and descending_async().
+     *
+     * await_suspend hands the sort to the shared WorkStealingPool and the pool thread
+     * resumes the coroutine; an exception from the sort is rethrown by co_await. Several
+     * coroutines may await the same container at once: the first task to run builds the
+     * order under the container's lock, and the others wait for that build instead of repeating it.
+     */
+    template<typename T, typename Storage>
+    template<bool Descending>
+    class MyContainer<T, Storage>::SortedOrderAwaiter {
+    public:
+        using Iterator = std::conditional_t<Descending, DescendingIterator<T, MyContainer>,
+                                            AscendingIterator<T, MyContainer>>;
+
+    private:
+        const MyContainer &container;
+        std::exception_ptr error;
+
+    public:
+        explicit SortedOrderAwaiter(const MyContainer &c) : container(c) {}
+
+        bool await_ready() const noexcept {
+            return container.orderGuard.ready.load(std::memory_order_acquire);
+        }
+
+        void await_suspend(std::coroutine_handle<> waiting) {
+            WorkStealingPool::shared().submit([this, waiting]() {
+                try {
+                    container.prepareSortedOrder();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                waiting.resume();
+            });
+        }
+
+        OrderView<Iterator> await_resume() {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            if constexpr (Descending) {
+                return OrderView<Iterator>(container.begin_descending_order(), container.end_descending_order());
+            } else {
+                return OrderView<Iterator>(container.begin_ascending_order(), container.end_ascending_order());
+            }
+        }
+    };
+#endif
+
+    namespace pmr {
+        /**
+         * @brief MyContainer whose elements, caches and iterator buffers all come from a
+         *        std::pmr::memory_resource passed to the constructor.
+         */
+        template<typename T = int>
+        using MyContainer = Container::MyContainer<T, std::pmr::vector<T>>;
+    }
+
+    /**
+     * @brief MyContainer that keeps up to N elements, and the index buffers for them, inline.
+     */
+    template<typename T = int, size_t N = 16>
+    using SmallContainer = MyContainer<T, SmallVector<T, N>>;
 }
 #endif //MYCONTAINER_H
@@ -0,0 +1,241 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef SHARDEDCONTAINER_H
+#define SHARDEDCONTAINER_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "MyContainer.h"
+#include "Algorithm/ThreadPool.h"
+
+namespace Container {
+    /**
+     * @brief Container split into independent MyContainer shards, one per core by default.
+     *
+     * Every thread adds to its own shard (handed out round-robin to threads as they first
+     * add), so inserts from up to shardCount() threads take different locks. Removals visit the shards one lock at a time.
+     * Before a sorted scan the shards that changed are sorted in parallel on the shared
+     * WorkStealingPool; the scan then merges the shards' cached permutations with a loser tree in
+     * O(n log k) without copying the elements.
+     *
+     * Adding and removing are thread-safe. As with MyContainer, iterators become invalid
+     * when the container is modified, so do not modify it while a sorted scan is running.
+     *
+     * @tparam T Element type.
+     * @tparam Storage Storage policy of every shard.
+     */
+    template<typename T = int, typename Storage = std::vector<T>>
+    class ShardedContainer {
+    public:
+        using Shard = MyContainer<T, Storage>;
+        using AscendingMergedIterator = MergedIterator<T, AscendingIterator<T, Shard>, std::less<T>>;
+        using DescendingMergedIterator = MergedIterator<T, DescendingIterator<T, Shard>, std::greater<T>>;
+
+    private:
+        // Padded to a cache line so shards owned by different threads do not share one
+        struct alignas(64) Slot {
+            mutable std::mutex lock;
+            Shard elements;
+            mutable bool sorted = false;
+        };
+
+        size_t count;
+        std::unique_ptr<Slot[]> shards;
+
+        static std::atomic<size_t> &nextThreadTicket() {
+            static std::atomic<size_t> ticket{0};
+            return ticket;
+        }
+
+        /**
+         * @brief Shard of the calling thread: threads get consecutive tickets the first time
+         *        they add, so k threads spread over min(k, shardCount()) different shards.
+         */
+        size_t shardOfThisThread() const {
+            thread_local const size_t ticket = nextThreadTicket().fetch_add(1, std::memory_order_relaxed);
+            return ticket % count;
+        }
+
+    public:
+        /**
+         * **\
+         * @param shardCount Number of shards, at least 1 (default: one per hardware thread).
+         */
+        explicit ShardedContainer(size_t shardCount = std::max(1u, std::thread::hardware_concurrency()))
+            : count(std::max<size_t>(shardCount, 1)), shards(new Slot[count]) {}
+
+        ShardedContainer(const ShardedContainer &) = delete;
+        ShardedContainer &operator=(const ShardedContainer &) = delete;
+
+        /**
+         * **\
+         * @brief Adds an element to the calling thread's shard.
+         * @param element Element to add.
+         */
+        void addElement(const T &element) {
+            addElementToShard(shardOfThisThread(), element);
+        }
+
+        /**
+         * **\
+         * @brief Adds an element to a chosen shard.
+         * @param shard Shard index, below shardCount().
+         * @param element Element to add.
+         * @throws std::out_of_range if shard is not smaller than shardCount().
+         */
+        void addElementToShard(size_t shard, const T &element) {
+            if (shard >= count) {
+                throw std::out_of_range("ShardedContainer: shard index out of range");
+            }
+            Slot &slot = shards[shard];
+            std::lock_guard<std::mutex> guard(slot.lock);
+            slot.elements.addElement(element);
+            slot.sorted = false;
+        }
+
+        /**
+         * **\
+         * @brief Removes every occurrence of an element without throwing on a miss.
+         * @param item The element to remove.
+         * @return Number of elements removed (0 if the element is not found).
+         */
+        size_t tryRemoveElement(const T &item) {
+            size_t removed = 0;
+            for (size_t s = 0; s < count; ++s) {
+                std::lock_guard<std::mutex> guard(shards[s].lock);
+                const size_t here = shards[s].elements.tryRemoveElement(item);
+                if (here > 0) {
+                    shards[s].sorted = false;
+                    removed += here;
+                }
+            }
+            return removed;
+        }
+
+        /**
+         * **\
+         * @brief Removes every occurrence of an element from the container.
+         * @param item The element to remove.
+         * @throws std::runtime_error if the element is not found.
+         */
+        void removeElement(const T &item) {
+            if (tryRemoveElement(item) == 0) {
+                throw std::runtime_error("Element not found in container");
+            }
+        }
+
+        /**
+         * **\
+         * @brief Removes one occurrence of an element, looking in the calling thread's shard first.
+         * @param item The element to remove.
+         * @return true if an element was removed.
+         */
+        bool removeOne(const T &item) {
+            const size_t first = shardOfThisThread();
+            for (size_t i = 0; i < count; ++i) {
+                Slot &slot = shards[(first + i) % count];
+                std::lock_guard<std::mutex> guard(slot.lock);
+                if (slot.elements.removeOne(item)) {
+                    slot.sorted = false;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * **\
+         * @brief Returns the number of elements in all shards.
+         */
+        size_t size() const {
+            size_t total = 0;
+            for (size_t s = 0; s < count; ++s) {
+                std::lock_guard<std::mutex> guard(shards[s].lock);
+                total += shards[s].elements.size();
+            }
+            return total;
+        }
+
+        /**
+         * **\
+         * @brief Returns the number of shards.
+         */
+        size_t shardCount() const { return count; }
+
+        /**
+         * **\
+         * @brief Gives read access to one shard.
+         * @param s Shard index, below shardCount().
+         * @throws std::out_of_range if s is not smaller than shardCount().
+         */
+        const Shard &shard(size_t s) const {
+            if (s >= count) {
+                throw std::out_of_range("ShardedContainer: shard index out of range");
+            }
+            return shards[s].elements;
+        }
+
+        /**
+         * **\
+         * @brief Sorts every shard that changed since its last sort, in parallel.
+         *
+         * Called by the sorted-order begin functions, so it is only needed to take the
+         * sort off the first scan.
+         */
+        void prepareSortedOrder() const {
+            std::vector<size_t> stale;
+            for (size_t s = 0; s < count; ++s) {
+                std::lock_guard<std::mutex> guard(shards[s].lock);
+                if (!shards[s].sorted) stale.push_back(s);
+            }
+            auto sortShard = [this](size_t s) {
+                std::lock_guard<std::mutex> guard(shards[s].lock);
+                shards[s].elements.prepareSortedOrder();
+                shards[s].sorted = true;
+            };
+            WorkStealingPool::shared().parallel_for(0, stale.size(), 1, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    sortShard(stale[i]);
+                }
+            });
+        }
+
+        /**
+        * ⚠️ Warning:
+        * Iterators become invalid if the container is modified (via addElement or removeElement).
+        */
+
+        AscendingMergedIterator begin_ascending_order() const {
+            prepareSortedOrder();
+            std::vector<std::pair<AscendingIterator<T, Shard>, AscendingIterator<T, Shard>>> runs;
+            runs.reserve(count);
+            for (size_t s = 0; s < count; ++s) {
+                runs.emplace_back(shards[s].elements.begin_ascending_order(), shards[s].elements.end_ascending_order());
+            }
+            return AscendingMergedIterator(std::move(runs), size());
+        }
+
+        AscendingMergedIterator end_ascending_order() const { return AscendingMergedIterator(size()); }
+
+        DescendingMergedIterator begin_descending_order() const {
+            prepareSortedOrder();
+            std::vector<std::pair<DescendingIterator<T, Shard>, DescendingIterator<T, Shard>>> runs;
+            runs.reserve(count);
+            for (size_t s = 0; s < count; ++s) {
+                runs.emplace_back(shards[s].elements.begin_descending_order(), shards[s].elements.end_descending_order());
+            }
+            return DescendingMergedIterator(std::move(runs), size());
+        }
+
+        DescendingMergedIterator end_descending_order() const { return DescendingMergedIterator(size()); }
+    };
+}
+
+#endif // SHARDEDCONTAINER_H
@@ -0,0 +1,335 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef STATICCONTAINER_H
+#define STATICCONTAINER_H
+
+#include <iostream>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <initializer_list>
+#include "ContainerConfig.h"
+#include "Algorithm/SortingNetwork.h"
+#include "Storage/FixedVector.h"
+#include "Iterator/AscendingOrder.h"
+#include "Iterator/DescendingOrder.h"
+#include "Iterator/Order.h"
+#include "Iterator/SideCrossOrder.h"
+#include "Iterator/ReverseOrder.h"
+#include "Iterator/MiddleOutOrder.h"
+
+namespace Container {
+    /**
+     * @brief Fixed-capacity container with the traversal orders of MyContainer and no heap use.
+     *
+     * Elements, the ascending permutation and every iterator buffer are inline arrays of N
+     * entries, so nothing here ever allocates. Adding to a full container throws
+     * std::length_error (tryAddElement reports it instead); everything that cannot fail is
+     * noexcept. Orders match MyContainer, ties included.
+     *
+     * The ascending permutation is kept up to date by every mutation (a binary-search insert
+     * per add, one remapping pass per removal) instead of being sorted lazily, so sorted scans
+     * never write to the container and all of it works in constant expressions under C++20:
+     * lookup tables can be built by iterating any order at compile time. Bulk construction
+     * from an initializer list sorts once, with an unrolled sorting network when N is small.
+     *
+     * @tparam T Element type.
+     * @tparam N Maximum number of elements.
+     */
+    template<typename T = int, size_t N = 64>
+    class StaticContainer {
+    public:
+        using IndexBuffer = FixedVector<size_t, N>;
+
+        using ScratchIndexBuffer = FixedVector<size_t, N>;
+
+    private:
+        static constexpr bool nothrowRemove = std::is_nothrow_move_assignable_v<T>
+                                              && noexcept(std::declval<const T &>() == std::declval<const T &>());
+
+        // Adding copies the element and binary-searches the permutation with operator<
+        static constexpr bool nothrowAdd = std::is_nothrow_copy_constructible_v<T>
+                                           && noexcept(std::declval<const T &>() < std::declval<const T &>());
+
+        FixedVector<T, N> elements;
+
+        // Ascending permutation of storage positions, always in sync with elements
+        IndexBuffer ascendingCache;
+
+        /**
+         * @brief Every stored slot is live; removal is always eager here.
+         */
+        CONTAINER_CONSTEXPR bool isLive(size_t) const noexcept { return true; }
+
+        /**
+         * @brief Returns the ascending permutation of storage positions.
+         */
+        CONTAINER_CONSTEXPR const IndexBuffer &ascendingPositions() const noexcept { return ascendingCache; }
+
+        CONTAINER_CONSTEXPR void sortAll();
+
+        /**
+         * @brief Creates a temporary index buffer of n elements inside the iterator.
+         */
+        CONTAINER_CONSTEXPR ScratchIndexBuffer makeScratchBuffer(size_t n) const { return ScratchIndexBuffer(n, 0); }
+
+        /**
+         * @brief Ranks and storage positions coincide without tombstones.
+         */
+        template<typename Buffer>
+        CONTAINER_CONSTEXPR void ranksToPositions(Buffer &) const noexcept {}
+
+    public:
+        // Give iterators access to private elements
+        friend class AscendingIterator<T, StaticContainer>;
+        friend class DescendingIterator<T, StaticContainer>;
+        friend class SideCrossIterator<T, StaticContainer>;
+        friend class ReverseIterator<T, StaticContainer>;
+        friend class OrderIterator<T, StaticContainer>;
+        friend class MiddleOutIterator<T, StaticContainer>;
+
+        CONTAINER_CONSTEXPR StaticContainer() noexcept = default;
+
+        /**
+         * **\
+         * @brief Constructs a container holding the given elements in insertion order.
+         *
+         * The ascending permutation is built with a single sort instead of one insert per element.
+         * @param init Elements to add.
+         * @throws std::length_error if there are more than N elements.
+         */
+        CONTAINER_CONSTEXPR StaticContainer(std::initializer_list<T> init) {
+            if (init.size() > N) {
+                throw std::length_error("StaticContainer: capacity exceeded");
+            }
+            for (const T &element : init) {
+                elements.push_back(element);
+            }
+            sortAll();
+        }
+
+        CONTAINER_CONSTEXPR void addElement(const T &element);
+
+        CONTAINER_CONSTEXPR bool tryAddElement(const T &element) noexcept(nothrowAdd);
+
+        CONTAINER_CONSTEXPR void removeElement(const T &item);
+
+        CONTAINER_CONSTEXPR size_t tryRemoveElement(const T &item) noexcept(nothrowRemove);
+
+        CONTAINER_CONSTEXPR bool removeOne(const T &item) noexcept(nothrowRemove);
+
+        /**
+         * **\
+         * @brief Returns the number of elements currently stored.
+         * @return Size of the container.
+         */
+        CONTAINER_CONSTEXPR size_t size() const noexcept { return elements.size(); }
+
+        /**
+         * **\
+         * @brief Returns the fixed capacity N.
+         */
+        static constexpr size_t capacity() noexcept { return N; }
+
+        /**
+         * **\
+         * @brief Tells whether another element would not fit.
+         */
+        CONTAINER_CONSTEXPR bool full() const noexcept { return elements.full(); }
+
+        /**
+     * ⚠️ Warning:
+     * Iterators become invalid if the container is modified (via addElement or removeElement).
+     * Make sure to avoid modifying the container while iterating over it.
+     */
+
+        CONTAINER_CONSTEXPR AscendingIterator<T, StaticContainer> begin_ascending_order() const { return AscendingIterator<T, StaticContainer>(*this, 0); }
+        CONTAINER_CONSTEXPR AscendingIterator<T, StaticContainer> end_ascending_order() const { return AscendingIterator<T, StaticContainer>(*this, size()); }
+
+        CONTAINER_CONSTEXPR DescendingIterator<T, StaticContainer> begin_descending_order() const { return DescendingIterator<T, StaticContainer>(*this, 0); }
+        CONTAINER_CONSTEXPR DescendingIterator<T, StaticContainer> end_descending_order() const { return DescendingIterator<T, StaticContainer>(*this, size()); }
+
+        CONTAINER_CONSTEXPR SideCrossIterator<T, StaticContainer> begin_side_cross_order() const { return SideCrossIterator<T, StaticContainer>(*this, 0); }
+        CONTAINER_CONSTEXPR SideCrossIterator<T, StaticContainer> end_side_cross_order() const { return SideCrossIterator<T, StaticContainer>(*this, size()); }
+
+        CONTAINER_CONSTEXPR ReverseIterator<T, StaticContainer> begin_reverse_order() const { return ReverseIterator<T, StaticContainer>(*this, 0); }
+        CONTAINER_CONSTEXPR ReverseIterator<T, StaticContainer> end_reverse_order() const { return ReverseIterator<T, StaticContainer>(*this, size()); }
+
+        CONTAINER_CONSTEXPR OrderIterator<T, StaticContainer> begin_order() const { return OrderIterator<T, StaticContainer>(*this, 0); }
+        CONTAINER_CONSTEXPR OrderIterator<T, StaticContainer> end_order() const { return OrderIterator<T, StaticContainer>(*this, size()); }
+
+        CONTAINER_CONSTEXPR MiddleOutIterator<T, StaticContainer> begin_middle_out_order() const { return MiddleOutIterator<T, StaticContainer>(*this, 0); }
+        CONTAINER_CONSTEXPR MiddleOutIterator<T, StaticContainer> end_middle_out_order() const { return MiddleOutIterator<T, StaticContainer>(*this, size()); }
+
+        /**
+        * **\
+        * @brief Outputs the container elements to a stream.
+        * @param os Output stream.
+        * @param container Container to print.
+        * @return Reference to the output stream.
+        */
+        friend std::ostream &operator<<(std::ostream &os, const StaticContainer &container) {
+            os << "[";
+            for (size_t i = 0; i < container.elements.size(); ++i) {
+                if (i > 0) {
+                    os << ", ";
+                }
+                os << container.elements[i];
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    /**
+     * **\
+     * @brief Adds an element to the container.
+     * @param element Element to add.
+     * @throws std::length_error if the container already holds N elements.
+     */
+    template<typename T, size_t N>
+    CONTAINER_CONSTEXPR void StaticContainer<T, N>::addElement(const T &element) {
+        if (full()) {
+            throw std::length_error("StaticContainer: capacity exceeded");
+        }
+        tryAddElement(element);
+    }
+
+    /**
+     * **\
+     * @brief Adds an element if there is room for it.
+     * @param element Element to add.
+     * @return false if the container was full and nothing was added.
+     */
+    template<typename T, size_t N>
+    CONTAINER_CONSTEXPR bool StaticContainer<T, N>::tryAddElement(const T &element) noexcept(nothrowAdd) {
+        if (full()) return false;
+        const size_t pos = elements.size();
+        elements.push_back(element);
+        // Equal values keep insertion order, so the new position goes after them
+        const auto rank = std::upper_bound(ascendingCache.begin(), ascendingCache.end(), pos,
+                                           [&](size_t a, size_t b) { return elements[a] < elements[b]; });
+        ascendingCache.push_back(pos);
+        std::rotate(rank, ascendingCache.end() - 1, ascendingCache.end());
+        return true;
+    }
+
+    /**
+     * **\
+     * @brief Removes every occurrence of an element from the container.
+     * @param item The element to remove.
+     * @throws std::runtime_error if the element is not found.
+     */
+    template<typename T, size_t N>
+    CONTAINER_CONSTEXPR void StaticContainer<T, N>::removeElement(const T &item) {
+        if (tryRemoveElement(item) == 0) {
+            throw std::runtime_error("Element not found in container");
+        }
+    }
+
+    /**
+     * **\
+     * @brief Removes every occurrence of an element without throwing on a miss.
+     *
+     * Elements are compacted in one pass that also records where each survivor moved,
+     * and the ascending permutation is filtered and renumbered in a second pass.
+     * @param item The element to remove.
+     * @return Number of elements removed (0 if the element is not found).
+     */
+    template<typename T, size_t N>
+    CONTAINER_CONSTEXPR size_t StaticContainer<T, N>::tryRemoveElement(const T &item) noexcept(nothrowRemove) {
+        const size_t n = elements.size();
+        size_t newPosition[N] = {};
+        size_t out = 0;
+        for (size_t pos = 0; pos < n; ++pos) {
+            if (elements[pos] == item) {
+                newPosition[pos] = N;
+                continue;
+            }
+            if (out != pos) {
+                elements[out] = std::move(elements[pos]);
+            }
+            newPosition[pos] = out++;
+        }
+        if (out == n) return 0;
+        while (elements.size() > out) {
+            elements.pop_back();
+        }
+        size_t kept = 0;
+        for (size_t pos : ascendingCache) {
+            if (newPosition[pos] != N) {
+                ascendingCache[kept++] = newPosition[pos];
+            }
+        }
+        while (ascendingCache.size() > kept) {
+            ascendingCache.pop_back();
+        }
+        return n - out;
+    }
+
+    /**
+     * **\
+     * @brief Removes only the first occurrence of an element.
+     * @param item The element to remove.
+     * @return true if an element was removed, false if it was not found.
+     */
+    template<typename T, size_t N>
+    CONTAINER_CONSTEXPR bool StaticContainer<T, N>::removeOne(const T &item) noexcept(nothrowRemove) {
+        const size_t n = elements.size();
+        size_t pos = 0;
+        while (pos < n && !(elements[pos] == item)) {
+            ++pos;
+        }
+        if (pos == n) return false;
+        for (size_t next = pos + 1; next < n; ++next) {
+            elements[next - 1] = std::move(elements[next]);
+        }
+        elements.pop_back();
+        size_t kept = 0;
+        for (size_t entry : ascendingCache) {
+            if (entry != pos) {
+                ascendingCache[kept++] = entry > pos ? entry - 1 : entry;
+            }
+        }
+        ascendingCache.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Rebuilds the ascending permutation from scratch.
+     *
+     * Ties are broken by position, so the result is the stable order MyContainer produces.
+     * Capacities up to sortingNetworkMaxSize use the sorting network for N keys: positions
+     * past the last element act as padding that sorts after every element.
+     */
+    template<typename T, size_t N>
+    CONTAINER_CONSTEXPR void StaticContainer<T, N>::sortAll() {
+        const size_t n = elements.size();
+        const auto before = [&](size_t a, size_t b) -> bool {
+            if (a >= n || b >= n) {
+                return a < b;
+            }
+            return elements[a] < elements[b] || (!(elements[b] < elements[a]) && a < b);
+        };
+        if constexpr (N <= sortingNetworkMaxSize) {
+            std::array<size_t, N> order{};
+            for (size_t i = 0; i < N; ++i) {
+                order[i] = i;
+            }
+            network_sort<N>(order.data(), before);
+            ascendingCache.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                ascendingCache[i] = order[i];
+            }
+        } else {
+            ascendingCache.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                ascendingCache[i] = i;
+            }
+            std::sort(ascendingCache.begin(), ascendingCache.end(), before);
+        }
+    }
+}
+#endif //STATICCONTAINER_H
@@ -0,0 +1,203 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef CHUNKEDSTORAGE_H
+#define CHUNKEDSTORAGE_H
+
+#include <vector>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <cstddef>
+
+namespace Container {
+
+    /**
+     * @brief Storage policy made of fixed-size chunks behind a small chunk index.
+     *
+     * Appending never moves existing elements: when the last chunk is full a new one is
+     * allocated, so an append costs one chunk allocation at worst instead of a copy of the
+     * whole container, and element addresses stay stable until the element is removed.
+     * Only the chunk index (one pointer per ChunkSize elements) ever grows geometrically.
+     *
+     * Usage: MyContainer<T, ChunkedStorage<T>>.
+     *
+     * @tparam T Element type.
+     * @tparam ChunkSize Elements per chunk, a power of two.
+     * @tparam Allocator Allocator for the chunks and the chunk index.
+     */
+    template<typename T, size_t ChunkSize = 1024, typename Allocator = std::allocator<T>>
+    class ChunkedStorage {
+        static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+        using AllocTraits = std::allocator_traits<Allocator>;
+        using ChunkIndexAllocator = typename AllocTraits::template rebind_alloc<T *>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+
+        static constexpr size_t chunk_size = ChunkSize;
+
+    private:
+        Allocator alloc;
+        std::vector<T *, ChunkIndexAllocator> chunks;
+        size_t count = 0;
+
+        void addChunk() {
+            T *chunk = AllocTraits::allocate(alloc, ChunkSize);
+            try {
+                chunks.push_back(chunk);
+            } catch (...) {
+                AllocTraits::deallocate(alloc, chunk, ChunkSize);
+                throw;
+            }
+        }
+
+        void releaseChunks() {
+            clear();
+            for (T *chunk : chunks) {
+                AllocTraits::deallocate(alloc, chunk, ChunkSize);
+            }
+            chunks.clear();
+        }
+
+        /**
+         * @brief Makes sure a slot exists for one more element.
+         */
+        void ensureSlot() {
+            if (count == capacity()) {
+                addChunk();
+            }
+        }
+
+    public:
+        ChunkedStorage() : ChunkedStorage(Allocator()) {}
+
+        explicit ChunkedStorage(const Allocator &allocator)
+            : alloc(allocator), chunks(ChunkIndexAllocator(allocator)) {}
+
+        ChunkedStorage(const ChunkedStorage &other)
+            : ChunkedStorage(AllocTraits::select_on_container_copy_construction(other.alloc)) {
+            reserve(other.count);
+            for (size_t i = 0; i < other.count; ++i) {
+                push_back(other[i]);
+            }
+        }
+
+        ChunkedStorage(ChunkedStorage &&other) noexcept
+            : alloc(other.alloc), chunks(std::move(other.chunks)), count(other.count) {
+            other.chunks.clear();
+            other.count = 0;
+        }
+
+        /**
+         * @brief Copies the elements; the allocator of this storage is kept.
+         */
+        ChunkedStorage &operator=(const ChunkedStorage &other) {
+            if (this != &other) {
+                clear();
+                reserve(other.count);
+                for (size_t i = 0; i < other.count; ++i) {
+                    push_back(other[i]);
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Steals the chunks when both sides share an allocator, otherwise moves element-wise.
+         */
+        ChunkedStorage &operator=(ChunkedStorage &&other) {
+            if (this == &other) return *this;
+            if (alloc == other.alloc) {
+                releaseChunks();
+                chunks.swap(other.chunks);
+                count = other.count;
+                other.count = 0;
+            } else {
+                clear();
+                reserve(other.count);
+                for (size_t i = 0; i < other.count; ++i) {
+                    push_back(std::move(other[i]));
+                }
+                other.clear();
+            }
+            return *this;
+        }
+
+        ~ChunkedStorage() {
+            releaseChunks();
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        size_t size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief Number of element slots in the allocated chunks.
+         */
+        size_t capacity() const { return chunks.size() * ChunkSize; }
+
+        T &operator[](size_t i) { return chunks[i / ChunkSize][i % ChunkSize]; }
+
+        const T &operator[](size_t i) const { return chunks[i / ChunkSize][i % ChunkSize]; }
+
+        /**
+         * @brief Allocates chunks up front so that appends up to n elements allocate nothing.
+         * @param n Number of element slots required.
+         */
+        void reserve(size_t n) {
+            chunks.reserve((n + ChunkSize - 1) / ChunkSize);
+            while (capacity() < n) {
+                addChunk();
+            }
+        }
+
+        void push_back(const T &value) {
+            ensureSlot();
+            AllocTraits::construct(alloc, &(*this)[count], value);
+            ++count;
+        }
+
+        void push_back(T &&value) {
+            ensureSlot();
+            AllocTraits::construct(alloc, &(*this)[count], std::move(value));
+            ++count;
+        }
+
+        void pop_back() {
+            --count;
+            AllocTraits::destroy(alloc, &(*this)[count]);
+        }
+
+        void clear() {
+            while (count > 0) {
+                pop_back();
+            }
+        }
+
+        /**
+         * @brief Frees the chunks that hold no elements.
+         */
+        void shrink_to_fit() {
+            const size_t needed = (count + ChunkSize - 1) / ChunkSize;
+            while (chunks.size() > needed) {
+                AllocTraits::deallocate(alloc, chunks.back(), ChunkSize);
+                chunks.pop_back();
+            }
+            chunks.shrink_to_fit();
+        }
+    };
+
+    namespace pmr {
+        /**
+         * @brief Chunked storage whose chunks come from a std::pmr::memory_resource.
+         */
+        template<typename T, size_t ChunkSize = 1024>
+        using ChunkedStorage = Container::ChunkedStorage<T, ChunkSize, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+#endif // CHUNKEDSTORAGE_H
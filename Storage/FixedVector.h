@@ -0,0 +1,235 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef FIXEDVECTOR_H
+#define FIXEDVECTOR_H
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include "../ContainerConfig.h"
+
+namespace Container {
+
+    /**
+     * @brief Vector-like buffer of at most N elements stored inside the object.
+     *
+     * It never allocates: growing past N throws std::length_error instead. Elements are
+     * constructed in place, so T does not need to be default-constructible: such types are
+     * kept in union slots whose member is only alive while it holds an element. Trivial
+     * types use a plain array, which lets the whole buffer be used in constant expressions
+     * under C++20.
+     *
+     * @tparam T Element type.
+     * @tparam N Capacity.
+     */
+    template<typename T, size_t N>
+    class FixedVector {
+        static_assert(N > 0, "FixedVector needs a capacity of at least one element");
+
+    public:
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+    private:
+        static constexpr bool plainSlots = std::is_trivially_default_constructible_v<T>
+                                           && std::is_trivially_destructible_v<T>;
+
+        union LazySlot {
+            T value;
+
+            LazySlot() noexcept {}
+
+            ~LazySlot() {}
+        };
+
+        using Slot = std::conditional_t<plainSlots, T, LazySlot>;
+
+        size_t count = 0;
+        Slot storage[N]{};
+
+        CONTAINER_CONSTEXPR T *slot(size_t i) noexcept {
+            if constexpr (plainSlots) {
+                return storage + i;
+            } else {
+                return &storage[i].value;
+            }
+        }
+
+        CONTAINER_CONSTEXPR const T *slot(size_t i) const noexcept {
+            if constexpr (plainSlots) {
+                return storage + i;
+            } else {
+                return &storage[i].value;
+            }
+        }
+
+        template<typename... Args>
+        CONTAINER_CONSTEXPR void constructAt(size_t i, Args &&... args) {
+#if CONTAINER_HAS_CONSTEXPR
+            std::construct_at(slot(i), std::forward<Args>(args)...);
+#else
+            ::new (static_cast<void *>(slot(i))) T(std::forward<Args>(args)...);
+#endif
+        }
+
+        CONTAINER_CONSTEXPR void requireRoom(size_t n) const {
+            if (n > N) {
+                throw std::length_error("FixedVector: capacity exceeded");
+            }
+        }
+
+    public:
+        CONTAINER_CONSTEXPR FixedVector() noexcept = default;
+
+        /**
+         * @brief Creates n copies of value.
+         * @throws std::length_error if n exceeds N.
+         */
+        CONTAINER_CONSTEXPR FixedVector(size_t n, const T &value) {
+            resize(n, value);
+        }
+
+        CONTAINER_CONSTEXPR FixedVector(const FixedVector &other) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            for (; count < other.count; ++count) {
+                constructAt(count, other[count]);
+            }
+        }
+
+        CONTAINER_CONSTEXPR FixedVector(FixedVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            for (; count < other.count; ++count) {
+                constructAt(count, std::move(other[count]));
+            }
+            other.clear();
+        }
+
+        CONTAINER_CONSTEXPR FixedVector &operator=(const FixedVector &other) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                for (; count < other.count; ++count) {
+                    constructAt(count, other[count]);
+                }
+            }
+            return *this;
+        }
+
+        CONTAINER_CONSTEXPR FixedVector &operator=(FixedVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                for (; count < other.count; ++count) {
+                    constructAt(count, std::move(other[count]));
+                }
+                other.clear();
+            }
+            return *this;
+        }
+
+#if CONTAINER_HAS_CONSTEXPR
+        // Trivial element types keep the buffer trivially destructible, as a constant
+        // expression requires for buffers held in mutable members.
+        ~FixedVector() requires std::is_trivially_destructible_v<T> = default;
+
+        constexpr ~FixedVector() requires (!std::is_trivially_destructible_v<T>) {
+            clear();
+        }
+#else
+        ~FixedVector() {
+            clear();
+        }
+#endif
+
+        CONTAINER_CONSTEXPR size_t size() const noexcept { return count; }
+
+        CONTAINER_CONSTEXPR bool empty() const noexcept { return count == 0; }
+
+        CONTAINER_CONSTEXPR bool full() const noexcept { return count == N; }
+
+        static constexpr size_t capacity() noexcept { return N; }
+
+        CONTAINER_CONSTEXPR T &operator[](size_t i) noexcept { return *slot(i); }
+
+        CONTAINER_CONSTEXPR const T &operator[](size_t i) const noexcept { return *slot(i); }
+
+        CONTAINER_CONSTEXPR T *data() noexcept { return slot(0); }
+
+        CONTAINER_CONSTEXPR const T *data() const noexcept { return slot(0); }
+
+        CONTAINER_CONSTEXPR iterator begin() noexcept { return slot(0); }
+
+        CONTAINER_CONSTEXPR iterator end() noexcept { return slot(0) + count; }
+
+        CONTAINER_CONSTEXPR const_iterator begin() const noexcept { return slot(0); }
+
+        CONTAINER_CONSTEXPR const_iterator end() const noexcept { return slot(0) + count; }
+
+        CONTAINER_CONSTEXPR T &back() noexcept { return *slot(count - 1); }
+
+        CONTAINER_CONSTEXPR const T &back() const noexcept { return *slot(count - 1); }
+
+        /**
+         * @throws std::length_error if the vector is full.
+         */
+        CONTAINER_CONSTEXPR void push_back(const T &value) {
+            requireRoom(count + 1);
+            constructAt(count, value);
+            ++count;
+        }
+
+        /**
+         * @throws std::length_error if the vector is full.
+         */
+        CONTAINER_CONSTEXPR void push_back(T &&value) {
+            requireRoom(count + 1);
+            constructAt(count, std::move(value));
+            ++count;
+        }
+
+        CONTAINER_CONSTEXPR void pop_back() noexcept {
+            --count;
+            std::destroy_at(slot(count));
+        }
+
+        CONTAINER_CONSTEXPR void clear() noexcept {
+            while (count > 0) {
+                pop_back();
+            }
+        }
+
+        CONTAINER_CONSTEXPR void resize(size_t n) {
+            resize(n, T());
+        }
+
+        /**
+         * @throws std::length_error if n exceeds N.
+         */
+        CONTAINER_CONSTEXPR void resize(size_t n, const T &value) {
+            requireRoom(n);
+            while (count > n) {
+                pop_back();
+            }
+            for (; count < n; ++count) {
+                constructAt(count, value);
+            }
+        }
+
+        /**
+         * @brief Erases [from, to), shifting the tail down.
+         * @return Iterator to the element that followed the erased range.
+         */
+        CONTAINER_CONSTEXPR iterator erase(const_iterator from, const_iterator to) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            T *out = slot(0) + (from - slot(0));
+            const size_t removed = static_cast<size_t>(to - from);
+            std::move(out + removed, end(), out);
+            for (size_t i = 0; i < removed; ++i) {
+                pop_back();
+            }
+            return out;
+        }
+    };
+}
+
+#endif // FIXEDVECTOR_H
@@ -0,0 +1,134 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef HUGEPAGEALLOCATOR_H
+#define HUGEPAGEALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace Container {
+
+    /**
+     * @brief Counters of how HugePageAllocator satisfied large requests (process-wide).
+     */
+    struct HugePageStats {
+        std::atomic<size_t> hugetlbMappings{0};   // explicit 2 MB pages (MAP_HUGETLB)
+        std::atomic<size_t> thpMappings{0};       // 2 MB aligned mappings advised with MADV_HUGEPAGE
+        std::atomic<size_t> smallAllocations{0};  // below the threshold, served by operator new
+    };
+
+    inline HugePageStats &hugePageStats() {
+        static HugePageStats stats;
+        return stats;
+    }
+
+    /**
+     * @brief Allocator that backs large blocks with 2 MB pages to cut TLB misses.
+     *
+     * Requests of at least HUGE_PAGE_SIZE bytes are rounded up to whole 2 MB pages and
+     * mapped with MAP_HUGETLB when the system has reserved huge pages; otherwise they get a
+     * 2 MB aligned anonymous mapping advised with MADV_HUGEPAGE, so transparent huge pages
+     * can back it. Smaller requests, and every request on non-Linux systems, fall back to
+     * operator new. Everything is stateless, so all instances compare equal.
+     *
+     * Usage: MyContainer<T, std::vector<T, HugePageAllocator<T>>>. The container rebinds
+     * the allocator for its cached permutations and iterator buffers as well.
+     */
+    template<typename T>
+    class HugePageAllocator {
+    public:
+        using value_type = T;
+
+        static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+        HugePageAllocator() noexcept = default;
+
+        template<typename U>
+        HugePageAllocator(const HugePageAllocator<U> &) noexcept {}
+
+        T *allocate(size_t n) {
+            const size_t bytes = n * sizeof(T);
+#ifdef __linux__
+            if (bytes >= HUGE_PAGE_SIZE) {
+                return static_cast<T *>(mapHuge(roundUp(bytes)));
+            }
+#endif
+            ++hugePageStats().smallAllocations;
+            return static_cast<T *>(::operator new(bytes));
+        }
+
+        void deallocate(T *p, size_t n) noexcept {
+            const size_t bytes = n * sizeof(T);
+#ifdef __linux__
+            if (bytes >= HUGE_PAGE_SIZE) {
+                munmap(p, roundUp(bytes));
+                return;
+            }
+#endif
+            ::operator delete(p);
+        }
+
+        template<typename U>
+        bool operator==(const HugePageAllocator<U> &) const noexcept { return true; }
+
+        template<typename U>
+        bool operator!=(const HugePageAllocator<U> &) const noexcept { return false; }
+
+    private:
+        static size_t roundUp(size_t bytes) {
+            return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+
+#ifdef __linux__
+        /**
+         * @brief Maps length bytes (a multiple of 2 MB) on a 2 MB boundary.
+         * @throws std::bad_alloc if even a regular mapping fails.
+         */
+        static void *mapHuge(size_t length) {
+#ifdef MAP_HUGETLB
+            void *explicitPages = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (explicitPages != MAP_FAILED) {
+                ++hugePageStats().hugetlbMappings;
+                return explicitPages;
+            }
+#endif
+            // Over-map by one huge page and trim both ends so the block starts on a 2 MB boundary
+            const size_t padded = length + HUGE_PAGE_SIZE;
+            void *raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(uintptr_t(HUGE_PAGE_SIZE) - 1);
+            if (aligned > start) {
+                munmap(raw, aligned - start);
+            }
+            const uintptr_t end = start + padded;
+            if (end > aligned + length) {
+                munmap(reinterpret_cast<void *>(aligned + length), end - (aligned + length));
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(reinterpret_cast<void *>(aligned), length, MADV_HUGEPAGE);
+#endif
+            ++hugePageStats().thpMappings;
+            return reinterpret_cast<void *>(aligned);
+        }
+#endif
+    };
+
+    /**
+     * @brief Contiguous storage policy whose large blocks live on huge pages.
+     */
+    template<typename T>
+    using HugePageVector = std::vector<T, HugePageAllocator<T>>;
+}
+
+#endif // HUGEPAGEALLOCATOR_H
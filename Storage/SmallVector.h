@@ -0,0 +1,348 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include "StorageTraits.h"
+#include "../Algorithm/ScratchPool.h"
+
+namespace Container {
+
+    /**
+     * @brief Contiguous storage policy that keeps up to N elements inline.
+     *
+     * Elements live in a buffer inside the object until the (N+1)th append, which moves
+     * them to the heap; from then on it behaves like std::vector. A container using it
+     * also keeps its cached permutations, handle tables and iterator buffers in
+     * SmallVectors of the same N, so a container of at most N elements never touches the heap.
+     *
+     * Usage: MyContainer<T, SmallVector<T, N>> (or SmallContainer<T, N>).
+     *
+     * @tparam T Element type.
+     * @tparam N Number of elements stored inline.
+     * @tparam Allocator Allocator used once the elements spill to the heap.
+     */
+    template<typename T, size_t N = 16, typename Allocator = std::allocator<T>>
+    class SmallVector {
+        static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+        using AllocTraits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        static constexpr size_t inline_capacity = N;
+
+    private:
+        Allocator alloc;
+        T *first;
+        size_t count = 0;
+        size_t cap = N;
+        alignas(T) unsigned char inlineBuffer[N * sizeof(T)];
+
+        T *inlineData() { return reinterpret_cast<T *>(inlineBuffer); }
+
+        /**
+         * @brief Moves the elements into a heap block of newCap slots, or back inline.
+         * @param newCap New capacity, at least size().
+         */
+        void relocate(size_t newCap) {
+            T *target = newCap <= N ? inlineData() : AllocTraits::allocate(alloc, newCap);
+            if (target == first) return;
+            size_t moved = 0;
+            try {
+                for (; moved < count; ++moved) {
+                    AllocTraits::construct(alloc, target + moved, std::move_if_noexcept(first[moved]));
+                }
+            } catch (...) {
+                destroyRange(target, moved);
+                if (target != inlineData()) {
+                    AllocTraits::deallocate(alloc, target, newCap);
+                }
+                throw;
+            }
+            destroyRange(first, count);
+            releaseHeap();
+            first = target;
+            cap = newCap <= N ? N : newCap;
+        }
+
+        void destroyRange(T *from, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                AllocTraits::destroy(alloc, from + i);
+            }
+        }
+
+        void releaseHeap() {
+            if (!is_inline()) {
+                AllocTraits::deallocate(alloc, first, cap);
+            }
+        }
+
+        /**
+         * @brief Appends to a full buffer: moves everything into a heap block twice the size.
+         *
+         * The new element is constructed in the new block before the old elements are moved
+         * out and the old block is released, so arg may refer to an element of this vector.
+         * @param arg Value to construct the new element from.
+         */
+        template<typename Arg>
+        void growAndAppend(Arg &&arg) {
+            // cap is never below N, so the doubled capacity is always a heap block
+            const size_t newCap = cap > 0 ? 2 * cap : 1;
+            T *target = AllocTraits::allocate(alloc, newCap);
+            try {
+                AllocTraits::construct(alloc, target + count, std::forward<Arg>(arg));
+            } catch (...) {
+                AllocTraits::deallocate(alloc, target, newCap);
+                throw;
+            }
+            size_t moved = 0;
+            try {
+                for (; moved < count; ++moved) {
+                    AllocTraits::construct(alloc, target + moved, std::move_if_noexcept(first[moved]));
+                }
+            } catch (...) {
+                destroyRange(target, moved);
+                AllocTraits::destroy(alloc, target + count);
+                AllocTraits::deallocate(alloc, target, newCap);
+                throw;
+            }
+            destroyRange(first, count);
+            releaseHeap();
+            first = target;
+            cap = newCap;
+            ++count;
+        }
+
+    public:
+        SmallVector() : SmallVector(Allocator()) {}
+
+        explicit SmallVector(const Allocator &allocator) : alloc(allocator), first(inlineData()) {}
+
+        /**
+         * @brief Creates n copies of value.
+         */
+        SmallVector(size_t n, const T &value, const Allocator &allocator = Allocator()) : SmallVector(allocator) {
+            resize(n, value);
+        }
+
+        SmallVector(const SmallVector &other)
+            : SmallVector(AllocTraits::select_on_container_copy_construction(other.alloc)) {
+            reserve(other.count);
+            for (size_t i = 0; i < other.count; ++i) {
+                push_back(other[i]);
+            }
+        }
+
+        /**
+         * @brief Steals a heap block; inline elements are moved one by one.
+         */
+        SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : SmallVector(other.alloc) {
+            if (!other.is_inline()) {
+                first = other.first;
+                count = other.count;
+                cap = other.cap;
+                other.first = other.inlineData();
+                other.count = 0;
+                other.cap = N;
+            } else {
+                for (size_t i = 0; i < other.count; ++i) {
+                    AllocTraits::construct(alloc, first + i, std::move(other.first[i]));
+                }
+                count = other.count;
+                other.clear();
+            }
+        }
+
+        /**
+         * @brief Copies the elements; the allocator of this storage is kept.
+         */
+        SmallVector &operator=(const SmallVector &other) {
+            if (this != &other) {
+                clear();
+                reserve(other.count);
+                for (size_t i = 0; i < other.count; ++i) {
+                    push_back(other[i]);
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Steals a heap block when both sides share an allocator, otherwise moves element-wise.
+         */
+        SmallVector &operator=(SmallVector &&other) {
+            if (this == &other) return *this;
+            clear();
+            if (!other.is_inline() && alloc == other.alloc) {
+                releaseHeap();
+                first = other.first;
+                count = other.count;
+                cap = other.cap;
+                other.first = other.inlineData();
+                other.count = 0;
+                other.cap = N;
+            } else {
+                reserve(other.count);
+                for (size_t i = 0; i < other.count; ++i) {
+                    AllocTraits::construct(alloc, first + i, std::move(other.first[i]));
+                }
+                count = other.count;
+                other.clear();
+            }
+            return *this;
+        }
+
+        ~SmallVector() {
+            clear();
+            releaseHeap();
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        /**
+         * @brief Tells whether the elements are still in the inline buffer.
+         */
+        bool is_inline() const { return first == reinterpret_cast<const T *>(inlineBuffer); }
+
+        size_t size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+        size_t capacity() const { return cap; }
+
+        T &operator[](size_t i) { return first[i]; }
+
+        const T &operator[](size_t i) const { return first[i]; }
+
+        T *data() { return first; }
+
+        const T *data() const { return first; }
+
+        iterator begin() { return first; }
+
+        iterator end() { return first + count; }
+
+        const_iterator begin() const { return first; }
+
+        const_iterator end() const { return first + count; }
+
+        T &back() { return first[count - 1]; }
+
+        const T &back() const { return first[count - 1]; }
+
+        /**
+         * @brief Makes room for n elements; never allocates while n fits inline.
+         * @param n Number of element slots required.
+         */
+        void reserve(size_t n) {
+            if (n > cap) {
+                relocate(n);
+            }
+        }
+
+        void push_back(const T &value) {
+            if (count == cap) {
+                growAndAppend(value);
+                return;
+            }
+            AllocTraits::construct(alloc, first + count, value);
+            ++count;
+        }
+
+        void push_back(T &&value) {
+            if (count == cap) {
+                growAndAppend(std::move(value));
+                return;
+            }
+            AllocTraits::construct(alloc, first + count, std::move(value));
+            ++count;
+        }
+
+        void pop_back() {
+            --count;
+            AllocTraits::destroy(alloc, first + count);
+        }
+
+        void clear() {
+            destroyRange(first, count);
+            count = 0;
+        }
+
+        void resize(size_t n) {
+            resize(n, T());
+        }
+
+        void resize(size_t n, const T &value) {
+            while (count > n) {
+                pop_back();
+            }
+            if (n > cap) {
+                // value may be one of our elements; copy it before reserve frees the old block
+                const T copy(value);
+                reserve(n);
+                resize(n, copy);
+                return;
+            }
+            for (; count < n; ++count) {
+                AllocTraits::construct(alloc, first + count, value);
+            }
+        }
+
+        /**
+         * @brief Erases [from, to), shifting the tail down.
+         * @return Iterator to the element that followed the erased range.
+         */
+        iterator erase(const_iterator from, const_iterator to) {
+            T *out = first + (from - first);
+            const size_t removed = static_cast<size_t>(to - from);
+            if (removed == 0) return out;
+            std::move(out + removed, end(), out);
+            for (size_t i = 0; i < removed; ++i) {
+                pop_back();
+            }
+            return out;
+        }
+
+        /**
+         * @brief Moves the elements back inline if they fit, otherwise trims the heap block.
+         */
+        void shrink_to_fit() {
+            if (!is_inline() && count < cap) {
+                relocate(count);
+            }
+        }
+    };
+
+    template<typename T, size_t N, typename Allocator>
+    struct is_contiguous_storage<SmallVector<T, N, Allocator>> : std::true_type {};
+
+    // Index buffers of a small-buffer container stay inline for the same N
+    template<typename T, size_t N, typename Allocator, typename U>
+    struct index_buffer<SmallVector<T, N, Allocator>, U> {
+        using type = SmallVector<U, N, typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+    };
+
+    /**
+     * @brief Scratch buffers for small-buffer containers are SmallVectors too, so sorting
+     *        and iterating a container of at most N elements allocates nothing.
+     */
+    template<typename U, typename V, size_t N, typename Allocator>
+    auto make_scratch(const SmallVector<V, N, Allocator> &like, size_t n) {
+        using Rebound = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+        return SmallVector<U, N, Rebound>(n, U(), Rebound(like.get_allocator()));
+    }
+}
+
+#endif // SMALLVECTOR_H
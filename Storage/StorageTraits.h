@@ -0,0 +1,41 @@
+//Email:Edenhassin@gmail.com
+
+#ifndef STORAGETRAITS_H
+#define STORAGETRAITS_H
+
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+namespace Container {
+
+    /**
+     * @brief Tells whether a storage policy keeps its elements in one contiguous array.
+     *
+     * Contiguous storage exposes data(), so MyContainer searches and compacts it with the
+     * find_first / remove_all kernels of Algorithm/Search.h; other policies go through operator[].
+     */
+    template<typename Storage>
+    struct is_contiguous_storage : std::false_type {};
+
+    template<typename T, typename Allocator>
+    struct is_contiguous_storage<std::vector<T, Allocator>> : std::true_type {};
+
+    template<typename Storage>
+    inline constexpr bool is_contiguous_storage_v = is_contiguous_storage<Storage>::value;
+
+    /**
+     * @brief Buffer type MyContainer uses for index arrays (cached permutations, handle tables).
+     *
+     * A std::vector on the storage's rebound allocator unless the storage policy says otherwise.
+     */
+    template<typename Storage, typename U>
+    struct index_buffer {
+        using type = std::vector<U, typename std::allocator_traits<typename Storage::allocator_type>::template rebind_alloc<U>>;
+    };
+
+    template<typename Storage, typename U>
+    using index_buffer_t = typename index_buffer<Storage, U>::type;
+}
+
+#endif // STORAGETRAITS_H
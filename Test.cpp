@@ -5,8 +5,45 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "MyContainer.h"
+#include "StaticContainer.h"
+#include "ConcurrentContainer.h"
+#include "MultiProducerContainer.h"
+#include "ShardedContainer.h"
+#include <array>
+#include <numeric>
+#include <climits>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
 using namespace Container;
 
+// Counts global heap allocations so tests can check that a path stays off the global heap
+static std::atomic<size_t> globalAllocations{0};
+
+// Set to k > 0 to make the k-th following global allocation throw std::bad_alloc
+static std::atomic<size_t> failingAllocation{0};
+
+void *operator new(std::size_t size) {
+    ++globalAllocations;
+    size_t countdown = failingAllocation.load();
+    while (countdown > 0 && !failingAllocation.compare_exchange_weak(countdown, countdown - 1)) {
+    }
+    if (countdown == 1) throw std::bad_alloc();
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
 // Test the default template type of MyContainer (should be int)
 TEST_CASE("Default type of MyContainer is int") {
     MyContainer<> defaultContainer;  // no template parameter
@@ -15,9 +52,15 @@ TEST_CASE("Default type of MyContainer is int") {
     CHECK((defaultContainer.size() == 2));
 }
 
+// The basic suite runs against both the heap-backed and the fixed-capacity container
+using StaticInts = StaticContainer<int, 16>;
+TYPE_TO_STRING(MyContainer<int>);
+TYPE_TO_STRING(StaticInts);
+#define BASIC_SUITE_CONTAINERS MyContainer<int>, StaticInts
+
 // Test adding, removing, and throwing on missing element
-TEST_CASE("Basic container operations") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("Basic container operations", C, BASIC_SUITE_CONTAINERS) {
+    C container;
 
     // Check initial size is zero
     CHECK((container.size() == 0));
@@ -39,8 +82,8 @@ TEST_CASE("Basic container operations") {
 }
 
 // Check AscendingIterator produces sorted order
-TEST_CASE("AscendingIterator order") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("AscendingIterator order", C, BASIC_SUITE_CONTAINERS) {
+    C container;
     container.addElement(7);
     container.addElement(2);
     container.addElement(5);
@@ -62,7 +105,7 @@ TEST_CASE("AscendingIterator order") {
         CHECK((*it == 5));
     }
     SUBCASE("Post-increment it++") {
-        AscendingIterator<int> before = it++;
+        auto before = it++;
         CHECK((*before == 2));
         CHECK((*it == 5));
     }
@@ -75,8 +118,8 @@ TEST_CASE("AscendingIterator order") {
 }
 
 // Check DescendingIterator produces reversed sorted order
-TEST_CASE("DescendingIterator order") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("DescendingIterator order", C, BASIC_SUITE_CONTAINERS) {
+    C container;
     container.addElement(1);
     container.addElement(4);
     container.addElement(3);
@@ -98,7 +141,7 @@ TEST_CASE("DescendingIterator order") {
         CHECK((*it == 3));
     }
     SUBCASE("Post-increment it++") {
-        DescendingIterator<int> before = it++;
+        auto before = it++;
         CHECK((*before == 4));
         CHECK((*it == 3));
     }
@@ -111,8 +154,8 @@ TEST_CASE("DescendingIterator order") {
 }
 
 // Check SideCrossIterator alternates smallest/largest
-TEST_CASE("SideCrossIterator order") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("SideCrossIterator order", C, BASIC_SUITE_CONTAINERS) {
+    C container;
     container.addElement(1);
     container.addElement(3);
     container.addElement(5);
@@ -136,7 +179,7 @@ TEST_CASE("SideCrossIterator order") {
         CHECK((*it == 9));
     }
     SUBCASE("Post-increment it++") {
-        SideCrossIterator<int> before = it++;
+        auto before = it++;
         CHECK((*before == 1));
         CHECK((*it == 9));
     }
@@ -151,8 +194,8 @@ TEST_CASE("SideCrossIterator order") {
 }
 
 // Check ReverseIterator goes backwards by insertion order
-TEST_CASE("ReverseIterator order") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("ReverseIterator order", C, BASIC_SUITE_CONTAINERS) {
+    C container;
     container.addElement(10);
     container.addElement(20);
     container.addElement(30);
@@ -174,7 +217,7 @@ TEST_CASE("ReverseIterator order") {
         CHECK((*it == 20));
     }
     SUBCASE("Post-increment it++") {
-        ReverseIterator<int> before = it++;
+        auto before = it++;
         CHECK((*before == 30));
         CHECK((*it == 20));
     }
@@ -188,8 +231,8 @@ TEST_CASE("ReverseIterator order") {
 }
 
 // Check OrderIterator returns elements in insertion order
-TEST_CASE("OrderIterator order (insertion)") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("OrderIterator order (insertion)", C, BASIC_SUITE_CONTAINERS) {
+    C container;
     container.addElement(5);
     container.addElement(2);
     container.addElement(8);
@@ -211,7 +254,7 @@ TEST_CASE("OrderIterator order (insertion)") {
         CHECK((*it == 2));
     }
     SUBCASE("Post-increment it++") {
-        OrderIterator<int> before = it++;
+        auto before = it++;
         CHECK((*before == 5));
         CHECK((*it == 2));
     }
@@ -224,8 +267,8 @@ TEST_CASE("OrderIterator order (insertion)") {
 }
 
 // Check MiddleOutIterator starts at middle and alternates outwards
-TEST_CASE("MiddleOutIterator order") {
-    MyContainer<int> container;
+TEST_CASE_TEMPLATE("MiddleOutIterator order", C, BASIC_SUITE_CONTAINERS) {
+    C container;
     container.addElement(10);
     container.addElement(20);
     container.addElement(30);
@@ -249,7 +292,7 @@ TEST_CASE("MiddleOutIterator order") {
         CHECK((*it == 20));
     }
     SUBCASE("Post-increment it++") {
-        MiddleOutIterator<int> before = it++;
+        auto before = it++;
         CHECK((*before == 30));
         CHECK((*it == 20));
     }
@@ -264,8 +307,8 @@ TEST_CASE("MiddleOutIterator order") {
 }
 
 // Check all iterators are empty when container is empty
-TEST_CASE("Edge cases: empty container iterators") {
-    MyContainer<int> empty;
+TEST_CASE_TEMPLATE("Edge cases: empty container iterators", C, BASIC_SUITE_CONTAINERS) {
+    C empty;
 
     CHECK((empty.size() == 0));
 
@@ -310,3 +353,1405 @@ TEST_CASE("Container with std::string") {
     CHECK((names.size() == 2));
     CHECK_THROWS_AS(names.removeElement("yovel"), std::runtime_error);
 }
+
+// Check the counting-sort path for narrow integer ranges matches the comparison path
+TEST_CASE("Counting sort for small-range integers") {
+    const int values[] = {3, -2, 3, 0, 1, -2, 2, 1, 0, 3};
+    std::vector<int> expected(std::begin(values), std::end(values));
+    std::sort(expected.begin(), expected.end());
+
+    const size_t savedFactor = SortTuning::countingSortRangeFactor;
+    const size_t savedMinSize = SortTuning::countingSortMinSize;
+    SortTuning::countingSortMinSize = 0;
+    for (size_t factor : {size_t(0), size_t(4)}) {
+        SortTuning::countingSortRangeFactor = factor;
+        MyContainer<int> container;
+        for (int v : values)
+            container.addElement(v);
+
+        std::vector<int> ascending;
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it)
+            ascending.push_back(*it);
+        CHECK((ascending == expected));
+
+        std::vector<int> descending;
+        for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it)
+            descending.push_back(*it);
+        CHECK((descending == std::vector<int>(expected.rbegin(), expected.rend())));
+
+        std::vector<int> sideCross;
+        for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it)
+            sideCross.push_back(*it);
+        CHECK((sideCross == std::vector<int>{-2, 3, -2, 3, 0, 3, 0, 2, 1, 1}));
+    }
+    SortTuning::countingSortRangeFactor = savedFactor;
+    SortTuning::countingSortMinSize = savedMinSize;
+
+    // Wide spans fall back to the comparison sort
+    std::vector<size_t> sorted(3);
+    CHECK_FALSE(counting_sort_indices(std::vector<long>{0, 1000000, -1000000}, sorted, false));
+
+    // Containers below the minimum size stay on the comparison sort, even with a narrow span
+    const size_t cutoff = SortTuning::countingSortMinSize;
+    CHECK_FALSE(counting_sort_applies(cutoff - 1, 0));
+    CHECK(counting_sort_applies(cutoff, 0));
+    CHECK_FALSE(counting_sort_applies(cutoff, 4 * cutoff));
+
+    std::vector<int> below(cutoff - 1);
+    std::vector<int> atCutoff(cutoff);
+    for (size_t i = 0; i < cutoff; ++i) {
+        if (i + 1 < cutoff) below[i] = static_cast<int>((i * 7) % 5);
+        atCutoff[i] = static_cast<int>((i * 7) % 5);
+    }
+    sorted.resize(cutoff - 1);
+    CHECK_FALSE(counting_sort_indices(below, sorted, false));
+    sorted.resize(cutoff);
+    CHECK(counting_sort_indices(atCutoff, sorted, false));
+    bool stable = true;
+    for (size_t i = 1; i < cutoff; ++i) {
+        const int prev = atCutoff[sorted[i - 1]];
+        const int cur = atCutoff[sorted[i]];
+        if (cur < prev || (cur == prev && sorted[i] < sorted[i - 1])) stable = false;
+    }
+    CHECK(stable);
+}
+
+// Check the vector search/compaction kernels against std::find / std::remove on every tail length
+template<typename T>
+static bool kernelsMatchStandard(T present, T absent) {
+    bool ok = true;
+    for (size_t n = 0; n < 80; ++n) {
+        for (size_t stride : {size_t(1), size_t(3), size_t(7), size_t(100)}) {
+            std::vector<T> values(n, absent);
+            for (size_t i = 0; i < n; ++i)
+                values[i] = (i % stride == stride - 1) ? present : static_cast<T>(i % 5 + 2);
+            const size_t expectedFirst = static_cast<size_t>(std::find(values.begin(), values.end(), present) - values.begin());
+            std::vector<T> expected = values;
+            expected.erase(std::remove(expected.begin(), expected.end(), present), expected.end());
+
+            ok = ok && find_first(values.data(), n, present) == expectedFirst;
+            ok = ok && find_first(values.data(), n, absent) == n;
+            if (expectedFirst < n) {
+                values.resize(remove_all(values.data(), n, expectedFirst, present));
+                ok = ok && values == expected;
+            }
+        }
+    }
+    return ok;
+}
+
+TEST_CASE("Vector search and compaction kernels") {
+    CHECK(kernelsMatchStandard<int>(-1, 99));
+    CHECK(kernelsMatchStandard<unsigned>(0xFFFFFFFFu, 99u));
+    CHECK(kernelsMatchStandard<float>(-1.5f, 99.0f));
+    CHECK(kernelsMatchStandard<double>(-1.5, 99.0));
+    CHECK(kernelsMatchStandard<long long>(-1, 99));
+
+    // Same equality as operator==: -0.0 matches 0.0, NaN matches nothing
+    std::vector<double> signs(20, 1.0);
+    signs[13] = -0.0;
+    CHECK((find_first(signs.data(), signs.size(), 0.0) == 13));
+    std::vector<float> nans(20, std::nanf(""));
+    CHECK((find_first(nans.data(), nans.size(), std::nanf("")) == nans.size()));
+    CHECK((remove_all(nans.data(), nans.size(), 0, std::nanf("")) == nans.size()));
+}
+
+// Check removeElement on arithmetic types in contiguous storage
+TEST_CASE("Contiguous removal for arithmetic types") {
+    MyContainer<int> container;
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+        const int v = i % 7 == 0 ? -1 : i;
+        container.addElement(v);
+        if (v != -1) expected.push_back(v);
+    }
+
+    container.removeElement(-1);
+    std::vector<int> actual;
+    for (auto it = container.begin_order(); it != container.end_order(); ++it)
+        actual.push_back(*it);
+    CHECK((actual == expected));
+
+    // A miss leaves the container untouched
+    CHECK_THROWS_AS(container.removeElement(-1), std::runtime_error);
+    CHECK((container.size() == expected.size()));
+
+    // Match at the last element
+    container.removeElement(99);
+    CHECK((container.size() == expected.size() - 1));
+
+    MyContainer<double> doubles;
+    for (int i = 0; i < 40; ++i)
+        doubles.addElement(i % 2 ? 0.5 : 1.5);
+    doubles.removeElement(0.5);
+    CHECK((doubles.size() == 20));
+    for (auto it = doubles.begin_order(); it != doubles.end_order(); ++it)
+        CHECK((*it == 1.5));
+}
+
+// Test the exception-free removal API
+TEST_CASE("tryRemoveElement and removeOne") {
+    MyContainer<int> container;
+    for (int v : {4, 1, 4, 2, 4})
+        container.addElement(v);
+
+    CHECK((container.tryRemoveElement(9) == 0));
+    CHECK((container.size() == 5));
+
+    CHECK(container.removeOne(4));
+    std::vector<int> actual;
+    for (auto it = container.begin_order(); it != container.end_order(); ++it)
+        actual.push_back(*it);
+    CHECK((actual == std::vector<int>{1, 4, 2, 4}));
+
+    CHECK((container.tryRemoveElement(4) == 2));
+    CHECK((container.size() == 2));
+    CHECK_FALSE(container.removeOne(4));
+
+    MyContainer<std::string> names;
+    names.addElement("Eden");
+    names.addElement("Bob");
+    names.addElement("Eden");
+    CHECK(names.removeOne("Eden"));
+    CHECK((names.tryRemoveElement("Eden") == 1));
+    CHECK((names.tryRemoveElement("Alice") == 0));
+    CHECK((names.size() == 1));
+}
+
+// Test lazy (tombstone) removal and compaction
+TEST_CASE("Lazy removal with tombstones") {
+    MyContainer<int> container;
+    container.setLazyRemoval(true, 0.5);
+    for (int v : {10, 20, 30, 40, 50, 60})
+        container.addElement(v);
+
+    container.removeElement(20);
+    CHECK(container.removeOne(50));
+    CHECK((container.size() == 4));
+    CHECK((container.tombstoneCount() == 2));
+    CHECK_THROWS_AS(container.removeElement(20), std::runtime_error);
+
+    auto collect = [](auto begin, auto end) {
+        std::vector<int> out;
+        for (auto it = begin; it != end; ++it)
+            out.push_back(*it);
+        return out;
+    };
+    CHECK((collect(container.begin_order(), container.end_order()) == std::vector<int>{10, 30, 40, 60}));
+    CHECK((collect(container.begin_reverse_order(), container.end_reverse_order()) == std::vector<int>{60, 40, 30, 10}));
+    CHECK((collect(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{10, 30, 40, 60}));
+    CHECK((collect(container.begin_descending_order(), container.end_descending_order()) == std::vector<int>{60, 40, 30, 10}));
+    CHECK((collect(container.begin_side_cross_order(), container.end_side_cross_order()) == std::vector<int>{10, 60, 30, 40}));
+    CHECK((collect(container.begin_middle_out_order(), container.end_middle_out_order()) == std::vector<int>{40, 30, 60, 10}));
+
+    // Crossing the threshold compacts and keeps insertion order
+    container.removeElement(10);
+    container.removeElement(60);
+    CHECK((container.tombstoneCount() == 0));
+    CHECK((collect(container.begin_order(), container.end_order()) == std::vector<int>{30, 40}));
+
+    // Leaving lazy mode compacts immediately
+    container.removeElement(30);
+    CHECK((container.tombstoneCount() == 1));
+    container.setLazyRemoval(false);
+    CHECK((container.tombstoneCount() == 0));
+    CHECK((container.size() == 1));
+    CHECK((*container.begin_order() == 40));
+}
+
+// Test generational handles and O(1) removal by handle
+TEST_CASE("Element handles") {
+    MyContainer<int> container;
+    container.addElement(1);
+    auto h5 = container.addElementWithHandle(5);
+    auto h3 = container.addElementWithHandle(3);
+    container.addElement(9);
+    auto h7 = container.addElementWithHandle(7);
+
+    CHECK((container.get(h5) == 5));
+    CHECK((container.get(h7) == 7));
+    CHECK_FALSE(container.contains(MyContainer<int>::Handle{}));
+
+    CHECK(container.removeByHandle(h5));
+    CHECK_FALSE(container.removeByHandle(h5));
+    CHECK_FALSE(container.contains(h5));
+    CHECK_THROWS_AS(container.get(h5), std::out_of_range);
+    CHECK((container.size() == 4));
+
+    std::vector<int> ascending;
+    for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending == std::vector<int>{1, 3, 7, 9}));
+
+    // Value removal and compaction keep the remaining handles pointing at their elements
+    container.removeElement(1);
+    container.compact();
+    CHECK((container.tombstoneCount() == 0));
+    CHECK((container.get(h3) == 3));
+    CHECK((container.get(h7) == 7));
+
+    // Removing a tracked element by value makes its handle stale, and reused slots get a new generation
+    container.removeElement(3);
+    CHECK_FALSE(container.contains(h3));
+    auto h4 = container.addElementWithHandle(4);
+    CHECK((h4.slot == h3.slot || h4.slot == h5.slot));
+    CHECK_FALSE(container.contains(h3));
+    CHECK_FALSE(container.contains(h5));
+    CHECK((container.get(h4) == 4));
+
+    std::vector<int> order;
+    for (auto it = container.begin_order(); it != container.end_order(); ++it)
+        order.push_back(*it);
+    CHECK((order == std::vector<int>{9, 7, 4}));
+
+    // Lazy removal by value also makes the handle stale, before any compaction
+    MyContainer<int> lazy;
+    lazy.setLazyRemoval(true, 0.9);
+    for (int v = 0; v < 9; ++v)
+        lazy.addElement(v);
+    auto h42 = lazy.addElementWithHandle(42);
+    auto h43 = lazy.addElementWithHandle(43);
+    CHECK((lazy.tryRemoveElement(42) == 1));
+    CHECK((lazy.tombstoneCount() == 1));
+    CHECK_FALSE(lazy.contains(h42));
+    CHECK_THROWS_AS(lazy.get(h42), std::out_of_range);
+    CHECK_FALSE(lazy.removeByHandle(h42));
+    CHECK((lazy.size() == 10));
+    lazy.prepareSortedOrder();
+    CHECK_THROWS_AS(lazy.updateElement(h42, 1), std::out_of_range);
+
+    CHECK(lazy.removeOne(43));
+    CHECK_FALSE(lazy.contains(h43));
+    CHECK_FALSE(lazy.removeByHandle(h43));
+    CHECK((lazy.size() == 9));
+}
+
+// Test in-place updates and incremental repair of the cached sorted order
+TEST_CASE("updateElement keeps sorted orders consistent") {
+    MyContainer<int> container;
+    for (int v : {50, 10, 40, 20, 30})
+        container.addElement(v);
+    auto h = container.addElementWithHandle(60);
+
+    auto collect = [](auto begin, auto end) {
+        std::vector<int> out;
+        for (auto it = begin; it != end; ++it)
+            out.push_back(*it);
+        return out;
+    };
+    // Build the cached order before updating
+    CHECK((collect(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{10, 20, 30, 40, 50, 60}));
+
+    container.updateElement(h, 15);      // moves down
+    container.updateElement(size_t(1), 45); // 10 -> 45 moves up
+    container.updateElement(size_t(2), 40); // unchanged value
+    CHECK((collect(container.begin_order(), container.end_order()) == std::vector<int>{50, 45, 40, 20, 30, 15}));
+    CHECK((collect(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{15, 20, 30, 40, 45, 50}));
+    CHECK((collect(container.begin_descending_order(), container.end_descending_order()) == std::vector<int>{50, 45, 40, 30, 20, 15}));
+    CHECK((collect(container.begin_side_cross_order(), container.end_side_cross_order()) == std::vector<int>{15, 50, 20, 45, 30, 40}));
+
+    // Updates by index skip tombstones, and compaction remaps the cached order
+    container.setLazyRemoval(true, 0.9);
+    container.removeElement(50);
+    container.updateElement(size_t(0), 5);
+    CHECK((container.get(h) == 15));
+    CHECK((collect(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{5, 15, 20, 30, 40}));
+    container.compact();
+    container.updateElement(h, 35);
+    CHECK((collect(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{5, 20, 30, 35, 40}));
+    CHECK((collect(container.begin_order(), container.end_order()) == std::vector<int>{5, 40, 20, 30, 35}));
+
+    CHECK_THROWS_AS(container.updateElement(size_t(5), 1), std::out_of_range);
+    container.removeByHandle(h);
+    CHECK_THROWS_AS(container.updateElement(h, 1), std::out_of_range);
+
+    MyContainer<std::string> names;
+    for (const char *n : {"Bob", "Eden", "Alice"})
+        names.addElement(n);
+    CHECK((*names.begin_ascending_order() == "Alice"));
+    names.updateElement(size_t(1), "Aaron");
+    std::vector<std::string> sortedNames;
+    for (auto it = names.begin_ascending_order(); it != names.end_ascending_order(); ++it)
+        sortedNames.push_back(*it);
+    CHECK((sortedNames == std::vector<std::string>{"Aaron", "Alice", "Bob"}));
+}
+
+// Test reserve, capacity, shrink_to_fit and the growth factor
+TEST_CASE("Capacity control") {
+    MyContainer<int> container;
+    container.reserve(100);
+    CHECK((container.capacity() >= 100));
+    const size_t reserved = container.capacity();
+    for (int i = 0; i < 100; ++i)
+        container.addElement(i);
+    CHECK((container.capacity() == reserved));
+
+    container.setGrowthFactor(1.5);
+    container.addElement(100);
+    CHECK((container.capacity() == reserved + reserved / 2));
+    CHECK_THROWS_AS(container.setGrowthFactor(1.0), std::invalid_argument);
+
+    container.setLazyRemoval(true, 0.9);
+    for (int i = 0; i < 50; ++i)
+        container.removeElement(i);
+    CHECK((container.tombstoneCount() == 50));
+    container.shrink_to_fit();
+    CHECK((container.tombstoneCount() == 0));
+    CHECK((container.size() == 51));
+    CHECK((container.capacity() == 51));
+    CHECK((*container.begin_ascending_order() == 50));
+}
+
+// Test the chunked storage policy with every order
+TEST_CASE("Chunked storage") {
+    MyContainer<int, ChunkedStorage<int, 4>> container;
+    for (int v : {7, 15, 6, 1, 2, 9, 3, 11, 4, 8})
+        container.addElement(v);
+    CHECK((container.size() == 10));
+    CHECK((container.capacity() == 12));
+
+    // Appends never move existing elements
+    const int *first = &*container.begin_order();
+    for (int i = 0; i < 100; ++i)
+        container.addElement(100 + i);
+    CHECK((&*container.begin_order() == first));
+    for (int i = 0; i < 100; ++i)
+        container.removeElement(100 + i);
+
+    auto collect = [](auto begin, auto end) {
+        std::vector<int> out;
+        for (auto it = begin; it != end; ++it)
+            out.push_back(*it);
+        return out;
+    };
+    CHECK((collect(container.begin_order(), container.end_order()) == std::vector<int>{7, 15, 6, 1, 2, 9, 3, 11, 4, 8}));
+    CHECK((collect(container.begin_reverse_order(), container.end_reverse_order()) == std::vector<int>{8, 4, 11, 3, 9, 2, 1, 6, 15, 7}));
+    CHECK((collect(container.begin_ascending_order(), container.end_ascending_order()) == std::vector<int>{1, 2, 3, 4, 6, 7, 8, 9, 11, 15}));
+    CHECK((collect(container.begin_descending_order(), container.end_descending_order()) == std::vector<int>{15, 11, 9, 8, 7, 6, 4, 3, 2, 1}));
+    CHECK((collect(container.begin_side_cross_order(), container.end_side_cross_order()) == std::vector<int>{1, 15, 2, 11, 3, 9, 4, 8, 6, 7}));
+    CHECK((collect(container.begin_middle_out_order(), container.end_middle_out_order()) == std::vector<int>{9, 2, 3, 1, 11, 6, 4, 15, 8, 7}));
+
+    CHECK(container.removeOne(6));
+    CHECK((container.tryRemoveElement(42) == 0));
+    auto h = container.addElementWithHandle(5);
+    container.updateElement(h, 0);
+    CHECK((*container.begin_ascending_order() == 0));
+    container.shrink_to_fit();
+    CHECK((container.capacity() == 12));
+
+    MyContainer<std::string, ChunkedStorage<std::string, 2>> names;
+    names.addElement("Eden");
+    names.addElement("Bob");
+    names.addElement("Alice");
+    names.removeElement("Bob");
+    std::vector<std::string> sorted;
+    for (auto it = names.begin_ascending_order(); it != names.end_ascending_order(); ++it)
+        sorted.push_back(*it);
+    CHECK((sorted == std::vector<std::string>{"Alice", "Eden"}));
+}
+
+// Test that pmr containers keep elements, caches and iterator buffers on their memory resource
+TEST_CASE("Polymorphic memory resources") {
+    static std::byte buffer[256 * 1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    const size_t before = globalAllocations;
+    long sum = 0;
+    {
+        pmr::MyContainer<int> container(&arena);
+        for (int i = 0; i < 300; ++i)
+            container.addElement((i * 37) % 101);
+        container.setLazyRemoval(true);
+        container.removeElement(5);
+        auto h = container.addElementWithHandle(1000);
+        container.updateElement(h, -1);
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) sum += *it;
+        for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) sum += *it;
+        for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) sum += *it;
+        for (auto it = container.begin_reverse_order(); it != container.end_reverse_order(); ++it) sum += *it;
+        for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) sum += *it;
+        container.compact();
+
+        MyContainer<double, pmr::ChunkedStorage<double, 16>> chunked(&arena);
+        for (int i = 0; i < 100; ++i)
+            chunked.addElement(100.0 - i);
+        chunked.removeElement(50.0);
+        for (auto it = chunked.begin_ascending_order(); it != chunked.end_ascending_order(); ++it) sum += static_cast<long>(*it);
+    }
+    const size_t after = globalAllocations;
+
+    CHECK((after == before));
+    CHECK((sum != 0));
+    CHECK((arena.upstream_resource() == std::pmr::null_memory_resource()));
+}
+
+// Test that the scratch pool makes steady-state order rebuilds allocation-free
+TEST_CASE("Scratch pool reuse") {
+    MyContainer<int> container;
+    for (int i = 0; i < 500; ++i)
+        container.addElement((i * 7919) % 100003);
+    container.setLazyRemoval(true, 0.9);
+
+    auto scan = [&]() {
+        long sum = 0;
+        // Mutating first forces the cached sorted order to be rebuilt from scratch
+        container.addElement(-5);
+        container.removeOne(-5);
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); it++) sum += *it;
+        for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) sum += *it;
+        for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); it++) sum += *it;
+        for (auto it = container.begin_reverse_order(); it != container.end_reverse_order(); it++) sum += *it;
+        for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); it++) sum += *it;
+        container.compact();
+        return sum;
+    };
+
+    const long expected = scan();
+    const size_t allocationsBefore = globalAllocations;
+    const ScratchPoolStats statsBefore = scratchPoolStats();
+    bool sameSums = true;
+    for (int round = 0; round < 3; ++round)
+        sameSums = sameSums && scan() == expected;
+    const size_t allocationsAfter = globalAllocations;
+    const ScratchPoolStats statsAfter = scratchPoolStats();
+
+    CHECK(sameSums);
+    CHECK((allocationsAfter == allocationsBefore));
+    CHECK((statsAfter.hits > statsBefore.hits));
+    CHECK((statsAfter.misses == statsBefore.misses));
+    CHECK((statsAfter.hitRate() > 0.0));
+
+    ScratchPool<size_t>::trim();
+    ScratchBuffer<size_t> fresh(16);
+    CHECK((scratchPoolStats().misses == statsAfter.misses + 1));
+}
+
+// Test the huge-page allocator for small and large blocks
+TEST_CASE("Huge-page backed storage") {
+    HugePageAllocator<int> alloc;
+    int *small = alloc.allocate(16);
+    small[15] = 7;
+    alloc.deallocate(small, 16);
+
+    const size_t large = HugePageAllocator<int>::HUGE_PAGE_SIZE / sizeof(int) + 1;
+    int *big = alloc.allocate(large);
+    CHECK((reinterpret_cast<uintptr_t>(big) % HugePageAllocator<int>::HUGE_PAGE_SIZE == 0));
+    big[0] = 1;
+    big[large - 1] = 2;
+    CHECK((big[0] + big[large - 1] == 3));
+    alloc.deallocate(big, large);
+    CHECK((hugePageStats().hugetlbMappings + hugePageStats().thpMappings > 0));
+
+    MyContainer<int, HugePageVector<int>> container;
+    container.reserve(large);
+    for (int i = 0; i < 1000; ++i)
+        container.addElement(999 - i);
+    container.removeElement(500);
+    std::vector<int> ascending;
+    for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending.size() == 999));
+    CHECK(std::is_sorted(ascending.begin(), ascending.end()));
+    CHECK((*container.begin_reverse_order() == 0));
+}
+
+// Test that tiny small-buffer containers stay off the heap in every order
+TEST_CASE("Small-buffer storage") {
+    const size_t allocationsBefore = globalAllocations;
+    long sum = 0;
+    size_t visited = 0;
+    bool inlineBeforeSpill = false;
+    {
+        SmallContainer<int, 16> container;
+        for (int i = 0; i < 12; ++i)
+            container.addElement((i * 5) % 12);
+        container.removeElement(7);
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) sum += *it, ++visited;
+        for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) sum += *it, ++visited;
+        for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) sum += *it, ++visited;
+        for (auto it = container.begin_reverse_order(); it != container.end_reverse_order(); ++it) sum += *it, ++visited;
+        for (auto it = container.begin_order(); it != container.end_order(); ++it) sum += *it, ++visited;
+        for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) sum += *it, ++visited;
+        inlineBeforeSpill = container.capacity() == 16;
+    }
+    const size_t allocationsAfter = globalAllocations;
+    CHECK((allocationsAfter == allocationsBefore));
+    CHECK((visited == 6 * 11));
+    CHECK((sum == 6 * (66 - 7)));
+    CHECK(inlineBeforeSpill);
+
+    // Past N elements the storage spills to the heap and keeps working
+    SmallContainer<double, 4> spilled;
+    for (int i = 0; i < 40; ++i)
+        spilled.addElement(static_cast<double>((i * 13) % 40));
+    CHECK((spilled.capacity() > 4));
+    std::vector<double> ascending;
+    for (auto it = spilled.begin_ascending_order(); it != spilled.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending.size() == 40));
+    CHECK(std::is_sorted(ascending.begin(), ascending.end()));
+    spilled.removeElement(0.0);
+    CHECK((*spilled.begin_ascending_order() == 1.0));
+
+    // Non-trivial elements survive copies and moves inline and on the heap
+    SmallVector<std::string, 2> words;
+    words.push_back("alpha");
+    SmallVector<std::string, 2> inlineCopy(words);
+    SmallVector<std::string, 2> inlineMoved(std::move(inlineCopy));
+    CHECK(inlineMoved.is_inline());
+    CHECK((inlineMoved[0] == "alpha"));
+    words.push_back("beta");
+    words.push_back(words[0]);
+    CHECK_FALSE(words.is_inline());
+    SmallVector<std::string, 2> heapMoved(std::move(words));
+    CHECK((heapMoved.size() == 3));
+    CHECK((heapMoved[2] == "alpha"));
+    heapMoved.erase(heapMoved.begin(), heapMoved.begin() + 1);
+    heapMoved.shrink_to_fit();
+    CHECK(heapMoved.is_inline());
+    CHECK((heapMoved[0] == "beta"));
+    CHECK((heapMoved.back() == "alpha"));
+
+    // Moving an element of a full vector into itself: inline -> heap, then heap -> larger heap
+    const std::string longWord(64, 'x');
+    SmallVector<std::string, 2> self;
+    self.push_back(longWord);
+    self.push_back("second");
+    self.push_back(std::move(self[0]));
+    CHECK_FALSE(self.is_inline());
+    CHECK((self.size() == 3));
+    CHECK((self[2] == longWord));
+    self.push_back("fourth");
+    self.push_back(std::move(self[2]));
+    CHECK((self.size() == 5));
+    CHECK((self[4] == longWord));
+    CHECK((self[1] == "second"));
+
+    // Growing with copies of one of its own elements: inline -> heap, then heap -> larger heap
+    SmallVector<std::string, 2> filled;
+    filled.push_back(longWord);
+    filled.resize(5, filled[0]);
+    CHECK_FALSE(filled.is_inline());
+    filled.resize(40, filled[4]);
+    CHECK((filled.size() == 40));
+    CHECK((std::count(filled.begin(), filled.end(), longWord) == 40));
+}
+
+// A comparator network sorts every input iff it sorts every input of zeros and ones
+template<size_t N>
+bool networkSortsAllBinaryInputs() {
+    for (unsigned bits = 0; bits < (1u << N); ++bits) {
+        std::array<int, N> keys{};
+        for (size_t i = 0; i < N; ++i)
+            keys[i] = (bits >> i) & 1u;
+        network_sort<N>(keys.data(), [](int a, int b) { return a < b; });
+        if (!std::is_sorted(keys.begin(), keys.end()))
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("Sorting network for small capacities") {
+    CHECK(networkSortsAllBinaryInputs<1>());
+    CHECK(networkSortsAllBinaryInputs<2>());
+    CHECK(networkSortsAllBinaryInputs<3>());
+    CHECK(networkSortsAllBinaryInputs<5>());
+    CHECK(networkSortsAllBinaryInputs<7>());
+    CHECK(networkSortsAllBinaryInputs<8>());
+    CHECK(networkSortsAllBinaryInputs<11>());
+    CHECK(networkSortsAllBinaryInputs<16>());
+    CHECK((network::comparators<16>.size() == 63));
+
+    // Partly filled containers pad the network; ties keep insertion order
+    StaticContainer<int, 16> partial{7, 3, 7, -1, 3};
+    std::vector<int> ascending;
+    for (auto it = partial.begin_ascending_order(); it != partial.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending == std::vector<int>{-1, 3, 3, 7, 7}));
+    StaticContainer<std::pair<int, int>, 6> pairs{{2, 0}, {1, 5}, {2, 0}, {0, 9}};
+    auto it = pairs.begin_ascending_order();
+    CHECK(((*it).first == 0));
+    ++it;
+    CHECK(((*it).first == 1));
+}
+
+// The basic suite above also runs on StaticContainer; here: no heap use, duplicates and capacity
+TEST_CASE("StaticContainer matches MyContainer without heap use") {
+    StaticContainer<> defaultContainer;
+    defaultContainer.addElement(1);
+    CHECK((defaultContainer.size() == 1));
+    CHECK((StaticContainer<>::capacity() == 64));
+
+    const size_t allocationsBefore = globalAllocations;
+    StaticContainer<int, 8> container;
+    for (int v : {7, 2, 5, 2, 9})
+        container.addElement(v);
+    int ascending[8], descending[8], sideCross[8], reverse[8], order[8], middleOut[8];
+    size_t n = 0;
+    for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) ascending[n++] = *it;
+    n = 0;
+    for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) descending[n++] = *it;
+    n = 0;
+    for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) sideCross[n++] = *it;
+    n = 0;
+    for (auto it = container.begin_reverse_order(); it != container.end_reverse_order(); ++it) reverse[n++] = *it;
+    n = 0;
+    for (auto it = container.begin_order(); it != container.end_order(); ++it) order[n++] = *it;
+    n = 0;
+    for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) middleOut[n++] = *it;
+    const size_t removed = container.tryRemoveElement(2);
+    const bool removedOne = container.removeOne(9);
+    const size_t allocationsAfter = globalAllocations;
+
+    CHECK((allocationsAfter == allocationsBefore));
+    CHECK((std::vector<int>(ascending, ascending + 5) == std::vector<int>{2, 2, 5, 7, 9}));
+    CHECK((std::vector<int>(descending, descending + 5) == std::vector<int>{9, 7, 5, 2, 2}));
+    CHECK((std::vector<int>(sideCross, sideCross + 5) == std::vector<int>{2, 9, 2, 7, 5}));
+    CHECK((std::vector<int>(reverse, reverse + 5) == std::vector<int>{9, 2, 5, 2, 7}));
+    CHECK((std::vector<int>(order, order + 5) == std::vector<int>{7, 2, 5, 2, 9}));
+    CHECK((std::vector<int>(middleOut, middleOut + 5) == std::vector<int>{5, 2, 2, 7, 9}));
+    CHECK((removed == 2));
+    CHECK(removedOne);
+    CHECK((container.size() == 2));
+    CHECK_THROWS_AS(container.removeElement(99), std::runtime_error);
+
+    // Capacity is a hard limit
+    StaticContainer<int, 2> tiny;
+    CHECK(tiny.tryAddElement(1));
+    tiny.addElement(2);
+    CHECK(tiny.full());
+    CHECK_FALSE(tiny.tryAddElement(3));
+    CHECK_THROWS_AS(tiny.addElement(3), std::length_error);
+    static_assert(noexcept(tiny.tryAddElement(3)), "tryAddElement on int must be noexcept");
+    static_assert(noexcept(tiny.removeOne(3)), "removeOne on int must be noexcept");
+
+    // A comparison that may throw makes tryAddElement potentially throwing, instead of terminating
+    struct ThrowingLess {
+        int v;
+        bool operator<(const ThrowingLess &other) const {
+            if (v < 0 || other.v < 0) throw std::runtime_error("incomparable");
+            return v < other.v;
+        }
+        bool operator==(const ThrowingLess &other) const noexcept { return v == other.v; }
+    };
+    StaticContainer<ThrowingLess, 4> picky;
+    static_assert(!noexcept(picky.tryAddElement(ThrowingLess{1})), "a throwing operator< must not be noexcept");
+    picky.addElement(ThrowingLess{1});
+    CHECK_THROWS_AS(picky.tryAddElement(ThrowingLess{-1}), std::runtime_error);
+
+    // Non-arithmetic elements agree with MyContainer
+    StaticContainer<std::string, 4> names;
+    MyContainer<std::string> reference;
+    for (const char *name : {"Eden", "Alice", "Bob", "Alice"}) {
+        names.addElement(name);
+        reference.addElement(name);
+    }
+    std::vector<std::string> staticSide, referenceSide;
+    for (auto i = names.begin_side_cross_order(); i != names.end_side_cross_order(); ++i) staticSide.push_back(*i);
+    for (auto i = reference.begin_side_cross_order(); i != reference.end_side_cross_order(); ++i) referenceSide.push_back(*i);
+    CHECK((staticSide == referenceSide));
+    names.removeElement("Alice");
+    std::ostringstream printed;
+    printed << names;
+    CHECK((printed.str() == "[Eden, Bob]"));
+
+    // Larger capacities keep the ascending permutation sorted too
+    StaticContainer<double, 100> wide;
+    for (int i = 0; i < 100; ++i)
+        wide.addElement(static_cast<double>((i * 37) % 100));
+    double previous = -1.0;
+    bool sorted = true;
+    for (auto i = wide.begin_ascending_order(); i != wide.end_ascending_order(); ++i) {
+        sorted = sorted && previous <= *i;
+        previous = *i;
+    }
+    CHECK(sorted);
+}
+
+// Readers scan consistent snapshots while a writer keeps publishing new ones
+TEST_CASE("Concurrent container snapshots") {
+    ConcurrentContainer<int> shared;
+    shared.update([](MyContainer<int> &c) {
+        for (int i = 0; i < 200; ++i)
+            c.addElement((i * 37) % 200);
+    });
+    auto before = shared.snapshot();
+    CHECK((shared.version() == 1));
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<int> scans{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load() || scans.load() < 3) {
+                auto snap = shared.snapshot();
+                size_t seen = 0;
+                int previous = INT_MIN;
+                for (auto it = snap->begin_ascending_order(); it != snap->end_ascending_order(); ++it, ++seen) {
+                    if (*it < previous) ++inconsistent;
+                    previous = *it;
+                }
+                if (seen != snap->size()) ++inconsistent;
+                ++scans;
+            }
+        });
+    }
+    for (int i = 200; i < 400; ++i) {
+        shared.addElement(i);
+        if (i % 10 == 0) shared.removeOne(i - 200);
+    }
+    done = true;
+    for (auto &t : readers)
+        t.join();
+
+    CHECK((inconsistent.load() == 0));
+    CHECK((shared.size() == 380));
+    CHECK((shared.version() == 221));
+    // Old snapshots are untouched by later writes
+    CHECK((before->size() == 200));
+    CHECK_THROWS_AS(shared.removeElement(-1), std::runtime_error);
+    CHECK((shared.size() == 380));
+
+    // A removal that misses publishes nothing: same snapshot, same version
+    auto current = shared.snapshot();
+    CHECK((shared.tryRemoveElement(-1) == 0));
+    CHECK_FALSE(shared.removeOne(-1));
+    CHECK((shared.removeOne(0) == false));
+    CHECK((shared.version() == 221));
+    CHECK((shared.snapshot() == current));
+    CHECK(shared.removeOne(399));
+    CHECK((shared.version() == 222));
+}
+
+// Several threads start sorted scans of one unsorted container; one of them builds the cache
+TEST_CASE("Concurrent const scans share one sorted-order build") {
+    MyContainer<double> container;
+    container.setLazyRemoval(true, 0.9);
+    for (int i = 0; i < 5000; ++i)
+        container.addElement(static_cast<double>((i * 7919) % 5000));
+    container.removeOne(0.0);
+
+    std::atomic<int> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&, r]() {
+            size_t seen = 0;
+            double previous = -1;
+            if (r % 2 == 0) {
+                for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it, ++seen) {
+                    if (*it < previous) ++inconsistent;
+                    previous = *it;
+                }
+            } else {
+                for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it)
+                    ++seen;
+            }
+            if (seen != 4999) ++inconsistent;
+        });
+    }
+    for (auto &t : readers)
+        t.join();
+    CHECK((inconsistent.load() == 0));
+}
+
+// Several producers append without locks while a reader checks the published prefix
+TEST_CASE("Lock-free multi-producer appends") {
+    constexpr int producers = 4;
+    constexpr int perProducer = 5000;
+    MultiProducerContainer<long, 256> ingest(producers * perProducer);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::thread reader([&]() {
+        while (!done.load()) {
+            // Every published element is complete: values are encoded as producer * 1e6 + i + 1
+            ingest.for_each_published([&](long v) {
+                if (v <= 0 || v % 1000000 > perProducer) ++torn;
+            });
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int p = 0; p < producers; ++p) {
+        writers.emplace_back([&, p]() {
+            for (int i = 0; i < perProducer; ++i)
+                ingest.addElement(static_cast<long>(p) * 1000000 + i + 1);
+        });
+    }
+    for (auto &t : writers)
+        t.join();
+    done = true;
+    reader.join();
+
+    CHECK((torn.load() == 0));
+    CHECK((ingest.size() == static_cast<size_t>(producers * perProducer)));
+    MyContainer<long> sorted = ingest.snapshot();
+    std::vector<long> ascending;
+    for (auto it = sorted.begin_ascending_order(); it != sorted.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((std::adjacent_find(ascending.begin(), ascending.end()) == ascending.end()));
+    CHECK((ascending.front() == 1));
+    CHECK((ascending.back() == static_cast<long>(producers - 1) * 1000000 + perProducer));
+    CHECK_THROWS_AS(ingest.addElement(1), std::length_error);
+
+    // A large default capacity only allocates the chunk directory up front
+    const size_t allocationsBefore = globalAllocations;
+    MultiProducerContainer<long> roomy;
+    CHECK((globalAllocations - allocationsBefore <= 1));
+    CHECK((roomy.capacity() == size_t(1) << 24));
+
+    // The chunk is allocated before the slot is reserved, so a failed allocation strands nothing
+    MultiProducerContainer<long, 256> lazy(1000);
+    for (long v = 0; v < 256; ++v)
+        lazy.addElement(v);
+    failingAllocation = 1;
+    CHECK_THROWS_AS(lazy.addElement(256), std::bad_alloc);
+    failingAllocation = 0;
+    CHECK((lazy.size() == 256));
+    for (long v = 256; v < 1000; ++v)
+        lazy.addElement(v);
+    CHECK((lazy.size() == 1000));
+    CHECK((lazy[256] == 256));
+    CHECK((lazy[999] == 999));
+    CHECK_THROWS_AS(lazy.addElement(1000), std::length_error);
+}
+
+// Per-thread writers flush sorted batches that are merged into the cached order
+TEST_CASE("Buffered writers merge batches") {
+    MyContainer<int> shared;
+    std::mutex lock;
+    shared.setLazyRemoval(true, 0.9);
+    for (int v : {50, 10, 30, 10})
+        shared.addElement(v);
+    shared.removeOne(30);
+    shared.prepareSortedOrder();
+
+    {
+        MyContainer<int>::Writer writer(shared, lock, 3);
+        for (int v : {20, 10, 60, 5})
+            writer.addElement(v);
+        // The first full batch is visible, the fourth element is still buffered
+        CHECK((writer.pendingCount() == 1));
+        CHECK((shared.size() == 6));
+    }
+    CHECK((shared.size() == 7));
+    std::ostringstream insertion;
+    insertion << shared;
+    CHECK((insertion.str() == "[50, 10, 10, 20, 10, 60, 5]"));
+    std::vector<int> ascending;
+    for (auto it = shared.begin_ascending_order(); it != shared.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending == std::vector<int>{5, 10, 10, 10, 20, 50, 60}));
+
+    constexpr int threads = 4;
+    constexpr int perThread = 3000;
+    std::atomic<int> unsorted{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t]() {
+            MyContainer<int>::Writer writer(shared, lock, 128);
+            for (int i = 0; i < perThread; ++i) {
+                writer.addElement((i * 7919 + t) % 10007);
+                if (i % 500 == 0) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    int previous = INT_MIN;
+                    for (auto it = shared.begin_ascending_order(); it != shared.end_ascending_order(); ++it) {
+                        if (*it < previous) ++unsorted;
+                        previous = *it;
+                    }
+                }
+            }
+        });
+    }
+    for (auto &t : producers)
+        t.join();
+
+    CHECK((unsorted.load() == 0));
+    CHECK((shared.size() == 7 + threads * perThread));
+    ascending.clear();
+    for (auto it = shared.begin_ascending_order(); it != shared.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending.size() == shared.size()));
+    CHECK(std::is_sorted(ascending.begin(), ascending.end()));
+}
+
+// Shards are sorted in parallel and merged by a loser tree into one order
+TEST_CASE("Sharded container merged order") {
+    ShardedContainer<int> placed(5);
+    const std::vector<std::vector<int>> perShard = {{7, 3, 9}, {}, {1, 8, 3, 3}, {10}, {2, 6, 4, 5}};
+    for (size_t s = 0; s < perShard.size(); ++s)
+        for (int v : perShard[s])
+            placed.addElementToShard(s, v);
+    CHECK((placed.size() == 12));
+    CHECK_THROWS_AS(placed.addElementToShard(5, 1), std::out_of_range);
+
+    std::vector<int> ascending;
+    for (auto it = placed.begin_ascending_order(); it != placed.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending == std::vector<int>{1, 2, 3, 3, 3, 4, 5, 6, 7, 8, 9, 10}));
+    std::vector<int> descending;
+    for (auto it = placed.begin_descending_order(); it != placed.end_descending_order(); ++it)
+        descending.push_back(*it);
+    CHECK((descending == std::vector<int>{10, 9, 8, 7, 6, 5, 4, 3, 3, 3, 2, 1}));
+    auto end = placed.end_ascending_order();
+    CHECK_THROWS_AS(*end, std::out_of_range);
+    CHECK_THROWS_AS(++end, std::out_of_range);
+
+    CHECK((placed.tryRemoveElement(3) == 3));
+    CHECK(placed.removeOne(10));
+    CHECK_FALSE(placed.removeOne(10));
+    CHECK_THROWS_AS(placed.removeElement(42), std::runtime_error);
+    ascending.clear();
+    for (auto it = placed.begin_ascending_order(); it != placed.end_ascending_order(); ++it)
+        ascending.push_back(*it);
+    CHECK((ascending == std::vector<int>{1, 2, 4, 5, 6, 7, 8, 9}));
+
+    ShardedContainer<int> empty(3);
+    CHECK((empty.begin_ascending_order() == empty.end_ascending_order()));
+
+    constexpr int threads = 4;
+    constexpr int perThread = 2000;
+    ShardedContainer<int> ingest(threads);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i)
+                ingest.addElement(i * threads + t);
+        });
+    }
+    for (auto &t : producers)
+        t.join();
+    int expected = 0;
+    bool ordered = true;
+    for (auto it = ingest.begin_ascending_order(); it != ingest.end_ascending_order(); ++it)
+        ordered = ordered && *it == expected++;
+    CHECK(ordered);
+    CHECK((expected == threads * perThread));
+
+    // New threads are spread round-robin, so each of them fills a shard of its own
+    for (size_t s = 0; s < ingest.shardCount(); ++s)
+        CHECK((ingest.shard(s).size() == static_cast<size_t>(perThread)));
+    CHECK_THROWS_AS(ingest.shard(threads), std::out_of_range);
+}
+
+// Partitions are merged through their cached permutations, without a combined copy
+TEST_CASE("Merged order over several containers") {
+    MyContainer<int> monday, tuesday, wednesday;
+    for (int v : {12, 3, 7})
+        monday.addElement(v);
+    for (int v : {5, 7, 1, 20})
+        tuesday.addElement(v);
+
+    std::vector<int> ascending;
+    for (int v : merged_ascending(monday, tuesday, wednesday))
+        ascending.push_back(v);
+    CHECK((ascending == std::vector<int>{1, 3, 5, 7, 7, 12, 20}));
+    std::vector<int> descending;
+    for (int v : merged_descending(monday, tuesday, wednesday))
+        descending.push_back(v);
+    CHECK((descending == std::vector<int>{20, 12, 7, 7, 5, 3, 1}));
+
+    auto view = merged_ascending(monday, tuesday);
+    CHECK((view.size() == 7));
+    auto end = view.end();
+    CHECK_THROWS_AS(*end, std::out_of_range);
+
+    std::vector<MyContainer<int>> windows(6);
+    for (int i = 0; i < 600; ++i)
+        windows[static_cast<size_t>(i) % 6].addElement((i * 53) % 600);
+    windows[2].setLazyRemoval(true, 0.9);
+    windows[2].removeOne(2 * 53 % 600);
+    std::vector<int> merged;
+    for (int v : merged_ascending(windows))
+        merged.push_back(v);
+    CHECK((merged.size() == 599));
+    CHECK(std::is_sorted(merged.begin(), merged.end()));
+    CHECK((std::find(merged.begin(), merged.end(), 2 * 53 % 600) == merged.end()));
+
+    std::vector<int> fromStatic;
+    StaticContainer<int, 8> first{4, 1}, second{3, 2, 5};
+    for (int v : merged_descending(first, second))
+        fromStatic.push_back(v);
+    CHECK((fromStatic == std::vector<int>{5, 4, 3, 2, 1}));
+}
+
+// Ranges are spread over per-worker deques; idle workers steal, waiting callers help
+TEST_CASE("Work-stealing thread pool") {
+    WorkStealingPool pool(3);
+    CHECK((pool.threadCount() == 3));
+
+    std::vector<long> values(10000);
+    pool.parallel_for(0, values.size(), 64, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            values[i] = static_cast<long>(i) * 2;
+    });
+    CHECK((std::accumulate(values.begin(), values.end(), 0L) == 9999L * 10000));
+    CHECK((pool.executedCount() > 0));
+
+    // Nested parallel_for from inside a worker completes instead of deadlocking
+    std::atomic<int> inner{0};
+    pool.parallel_for(0, 8, 1, [&](size_t, size_t) {
+        pool.parallel_for(0, 16, 4, [&](size_t lo, size_t hi) { inner += static_cast<int>(hi - lo); });
+    });
+    CHECK((inner.load() == 8 * 16));
+
+    CHECK_THROWS_AS(pool.parallel_for(0, 100, 10, [](size_t lo, size_t) {
+        if (lo == 50) throw std::runtime_error("range failed");
+    }), std::runtime_error);
+
+    // A worker that queues tasks on its own deque and then waits leaves them to be stolen
+    const size_t stealsBefore = pool.stealCount();
+    std::atomic<int> done{0};
+    pool.submit([&]() {
+        for (int i = 0; i < 4; ++i)
+            pool.submit([&]() { ++done; });
+        while (done.load() < 4)
+            std::this_thread::yield();
+    });
+    while (done.load() < 4)
+        std::this_thread::yield();
+    CHECK((pool.stealCount() >= stealsBefore + 4));
+    CHECK((pool.queueDepth() == 0));
+
+    // A caller whose remaining ranges run elsewhere sleeps instead of spinning
+    WorkStealingPool single(1);
+    std::atomic<bool> started{false};
+    const std::clock_t cpuBefore = std::clock();
+    single.parallel_for(0, 2, 1, [&](size_t lo, size_t) {
+        if (lo == 1) {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        } else {
+            while (!started.load())
+                std::this_thread::yield();
+        }
+    });
+    const double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuBefore) / CLOCKS_PER_SEC;
+    CHECK((cpuMs < 100.0));
+
+    // Without workers the ranges still come in grain-sized pieces, in order
+    WorkStealingPool inline0(0);
+    std::vector<std::pair<size_t, size_t>> ranges;
+    inline0.parallel_for(0, 10, 3, [&](size_t lo, size_t hi) { ranges.emplace_back(lo, hi); });
+    CHECK((ranges == std::vector<std::pair<size_t, size_t>>{{0, 3}, {3, 6}, {6, 9}, {9, 10}}));
+    int calls = 0;
+    CHECK_THROWS_AS(inline0.parallel_for(0, 10, 3, [&](size_t lo, size_t) {
+        ++calls;
+        if (lo == 3) throw std::runtime_error("range failed");
+    }), std::runtime_error);
+    CHECK((calls == 4));
+
+    WorkStealingPool::shared();
+    CHECK_FALSE(WorkStealingPool::configureShared(2));
+}
+
+// Every order splits into independent ranges whose results combine in order
+TEST_CASE("Parallel traversal of every order") {
+    MyContainer<int> c;
+    for (int i = 0; i < 1000; ++i)
+        c.addElement((i * 389) % 1000 - 300);
+    c.setLazyRemoval(true, 0.9);
+    for (int v : {-300, 5, 77, 698})
+        c.removeOne(v);
+
+    auto collect = [](auto begin, auto end) {
+        std::vector<int> out;
+        for (; begin != end; ++begin)
+            out.push_back(*begin);
+        return out;
+    };
+    const std::vector<std::pair<Traversal, std::vector<int>>> expected = {
+        {Traversal::Insertion, collect(c.begin_order(), c.end_order())},
+        {Traversal::Ascending, collect(c.begin_ascending_order(), c.end_ascending_order())},
+        {Traversal::Descending, collect(c.begin_descending_order(), c.end_descending_order())},
+        {Traversal::SideCross, collect(c.begin_side_cross_order(), c.end_side_cross_order())},
+        {Traversal::Reverse, collect(c.begin_reverse_order(), c.end_reverse_order())},
+        {Traversal::MiddleOut, collect(c.begin_middle_out_order(), c.end_middle_out_order())},
+    };
+    auto concatenate = [](std::vector<int> a, std::vector<int> b) {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+    };
+    for (const auto &[order, sequence] : expected) {
+        CHECK((sequence.size() == 996));
+        const std::vector<int> parallel = c.parallel_transform_reduce(
+            order, std::vector<int>{}, concatenate, [](int v) { return std::vector<int>{v}; }, 37);
+        CHECK((parallel == sequence));
+
+        std::atomic<long> sum{0};
+        std::atomic<size_t> visited{0};
+        c.parallel_for_each(order, [&](int v) {
+            sum += v;
+            ++visited;
+        }, 50);
+        CHECK((visited.load() == sequence.size()));
+        CHECK((sum.load() == std::accumulate(sequence.begin(), sequence.end(), 0L)));
+    }
+
+    // Grains that divide the size exactly, cover it in one range or exceed it fold every element once
+    const std::vector<int> &ascending = expected[1].second;
+    for (size_t grain : {size_t(1), size_t(249), size_t(996), size_t(5000)}) {
+        const std::vector<int> parallel = c.parallel_transform_reduce(
+            Traversal::Ascending, std::vector<int>{}, concatenate, [](int v) { return std::vector<int>{v}; }, grain);
+        CHECK((parallel == ascending));
+    }
+
+    MyContainer<int> empty;
+    CHECK((empty.parallel_transform_reduce(Traversal::Ascending, 7, std::plus<int>(), [](int v) { return v; }) == 7));
+    CHECK((side_cross_rank(3, 5) == 3));
+    CHECK((middle_out_rank(4, 5) == 4));
+}
+
+// Side-cross and middle-out positions come from closed forms instead of a built permutation
+TEST_CASE("Closed-form side-cross and middle-out orders") {
+    for (int n = 0; n <= 40; ++n) {
+        MyContainer<int> c;
+        for (int i = 0; i < n; ++i)
+            c.addElement((i * 17) % 41);
+        if (n > 6) {
+            c.setLazyRemoval(true, 0.9);
+            c.removeOne((3 * 17) % 41);
+        }
+        std::vector<int> live;
+        for (auto it = c.begin_order(); it != c.end_order(); ++it)
+            live.push_back(*it);
+        std::vector<int> sorted = live;
+        std::sort(sorted.begin(), sorted.end());
+
+        // Reference: the two-pointer and alternating loops the orders are defined by
+        std::vector<int> sideCross;
+        for (size_t left = 0, right = sorted.size(); left < right; ++left) {
+            sideCross.push_back(sorted[left]);
+            if (left + 1 < right) sideCross.push_back(sorted[--right]);
+        }
+        std::vector<int> middleOut;
+        if (!live.empty()) {
+            const int mid = static_cast<int>(live.size()) / 2;
+            middleOut.push_back(live[static_cast<size_t>(mid)]);
+            for (int step = 1; middleOut.size() < live.size(); ++step) {
+                if (mid - step >= 0) middleOut.push_back(live[static_cast<size_t>(mid - step)]);
+                if (mid + step < static_cast<int>(live.size())) middleOut.push_back(live[static_cast<size_t>(mid + step)]);
+            }
+        }
+
+        std::vector<int> gotSideCross, gotMiddleOut;
+        for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it)
+            gotSideCross.push_back(*it);
+        for (auto it = c.begin_middle_out_order(); it != c.end_middle_out_order(); ++it)
+            gotMiddleOut.push_back(*it);
+        CHECK((gotSideCross == sideCross));
+        CHECK((gotMiddleOut == middleOut));
+    }
+
+    // With the sorted order cached, starting either scan allocates nothing
+    MyContainer<int> big;
+    for (int i = 0; i < 100000; ++i)
+        big.addElement(i % 977);
+    big.prepareSortedOrder();
+    const size_t before = globalAllocations;
+    auto sideCross = big.begin_side_cross_order();
+    auto middleOut = big.begin_middle_out_order();
+    const size_t after = globalAllocations;
+    CHECK((after == before));
+    CHECK((*sideCross == 0));
+    CHECK((*++sideCross == 976));
+    CHECK((*middleOut == 50000 % 977));
+}
+
+// Writers skip the sort; readers keep the last sorted snapshot until a resort publishes
+TEST_CASE("Background resort after writes") {
+    ConcurrentContainer<int> shared;
+    shared.setBackgroundResort(true);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::thread reader([&]() {
+        uint64_t lastVersion = 0;
+        while (!done.load()) {
+            auto snap = shared.snapshot();
+            const uint64_t version = shared.version();
+            if (version < lastVersion) ++inconsistent;
+            lastVersion = version;
+            int previous = INT_MIN;
+            size_t seen = 0;
+            for (auto it = snap->begin_ascending_order(); it != snap->end_ascending_order(); ++it, ++seen) {
+                if (*it < previous) ++inconsistent;
+                previous = *it;
+            }
+            if (seen != snap->size()) ++inconsistent;
+        }
+    });
+    for (int i = 0; i < 500; ++i)
+        shared.addElement((i * 211) % 500);
+    shared.waitForResort();
+    done = true;
+    reader.join();
+
+    CHECK((inconsistent.load() == 0));
+    CHECK((shared.version() == 500));
+    CHECK((shared.size() == 500));
+    auto snap = shared.snapshot();
+    int expected = 0;
+    bool ordered = true;
+    for (auto it = snap->begin_ascending_order(); it != snap->end_ascending_order(); ++it)
+        ordered = ordered && *it == expected++;
+    CHECK(ordered);
+
+    // Writes build on the newest written state even before it is published
+    shared.update([](MyContainer<int> &c) { c.addElement(-1); });
+    CHECK(shared.removeOne(-1));
+    CHECK_FALSE(shared.removeOne(-1));
+    shared.setBackgroundResort(false);
+    CHECK((shared.version() == 502));
+    CHECK((shared.size() == 500));
+    shared.addElement(1000);
+    CHECK((shared.version() == 503));
+    CHECK((shared.size() == 501));
+}
+
+#if CONTAINER_HAS_COROUTINES
+// Minimal fire-and-forget coroutine for driving co_await in tests
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+Detached collectAscending(const MyContainer<int> &c, std::vector<int> &out, std::thread::id &resumedOn,
+                          std::atomic<bool> &done) {
+    auto view = co_await c.ascending_async();
+    resumedOn = std::this_thread::get_id();
+    for (int v : view)
+        out.push_back(v);
+    done = true;
+}
+
+Detached collectDescending(const MyContainer<int> &c, std::vector<int> &out, std::atomic<bool> &done) {
+    for (int v : co_await c.descending_async())
+        out.push_back(v);
+    done = true;
+}
+
+// Sorting is awaited off the calling thread; generators stream every order lazily
+TEST_CASE("Coroutine ordering API") {
+    MyContainer<int> c;
+    for (int i = 0; i < 2000; ++i)
+        c.addElement((i * 769) % 2000);
+
+    std::vector<int> ascending;
+    std::thread::id resumedOn;
+    std::atomic<bool> done{false};
+    collectAscending(c, ascending, resumedOn, done);
+    while (!done.load())
+        std::this_thread::yield();
+    CHECK((ascending.size() == 2000));
+    CHECK(std::is_sorted(ascending.begin(), ascending.end()));
+    CHECK((resumedOn != std::this_thread::get_id()));
+
+    // Already sorted: the coroutine continues without suspending
+    std::vector<int> descending;
+    std::atomic<bool> descendingDone{false};
+    collectDescending(c, descending, descendingDone);
+    CHECK(descendingDone.load());
+    CHECK((descending.front() == 1999));
+    CHECK((descending.back() == 0));
+
+    // Two coroutines awaiting one unsorted container: the sort is built once, under its lock
+    MyContainer<int> twice;
+    for (int i = 0; i < 2000; ++i)
+        twice.addElement((i * 1237) % 2000);
+    std::vector<int> first;
+    std::vector<int> second;
+    std::thread::id firstResumedOn;
+    std::atomic<bool> firstDone{false};
+    std::atomic<bool> secondDone{false};
+    collectAscending(twice, first, firstResumedOn, firstDone);
+    collectDescending(twice, second, secondDone);
+    while (!firstDone.load() || !secondDone.load())
+        std::this_thread::yield();
+    CHECK((first.size() == 2000));
+    CHECK(std::is_sorted(first.begin(), first.end()));
+    CHECK((second == std::vector<int>(first.rbegin(), first.rend())));
+
+    c.setLazyRemoval(true, 0.9);
+    c.removeOne(0);
+    c.removeOne(1000);
+    auto collect = [](auto begin, auto end) {
+        std::vector<int> out;
+        for (; begin != end; ++begin)
+            out.push_back(*begin);
+        return out;
+    };
+    const std::vector<std::pair<Traversal, std::vector<int>>> expected = {
+        {Traversal::Insertion, collect(c.begin_order(), c.end_order())},
+        {Traversal::Ascending, collect(c.begin_ascending_order(), c.end_ascending_order())},
+        {Traversal::Descending, collect(c.begin_descending_order(), c.end_descending_order())},
+        {Traversal::SideCross, collect(c.begin_side_cross_order(), c.end_side_cross_order())},
+        {Traversal::Reverse, collect(c.begin_reverse_order(), c.end_reverse_order())},
+        {Traversal::MiddleOut, collect(c.begin_middle_out_order(), c.end_middle_out_order())},
+    };
+    for (const auto &[order, sequence] : expected) {
+        std::vector<int> streamed;
+        for (const int &v : c.generate(order))
+            streamed.push_back(v);
+        CHECK((streamed == sequence));
+    }
+
+    // Consumers can stop early; only the elements taken are produced
+    auto stream = c.generate(Traversal::Ascending);
+    auto it = stream.begin();
+    CHECK((*it == 1));
+    ++it;
+    CHECK((*it == 2));
+
+    MyContainer<int> empty;
+    auto none = empty.generate(Traversal::MiddleOut);
+    CHECK((none.begin() == none.end()));
+}
+#endif
+
+#if CONTAINER_HAS_CONSTEXPR
+// Lookup tables built by iterating orders at compile time
+constexpr StaticContainer<int, 8> configTable{40, 10, 60, 30, 20, 50};
+
+template<typename Begin, typename End>
+constexpr std::array<int, 6> tableFrom(Begin it, End end) {
+    std::array<int, 6> out{};
+    size_t i = 0;
+    for (; it != end; ++it)
+        out[i++] = *it;
+    return out;
+}
+
+constexpr std::array<int, 6> ascendingTable = tableFrom(configTable.begin_ascending_order(), configTable.end_ascending_order());
+constexpr std::array<int, 6> sideCrossTable = tableFrom(configTable.begin_side_cross_order(), configTable.end_side_cross_order());
+constexpr std::array<int, 6> middleOutTable = tableFrom(configTable.begin_middle_out_order(), configTable.end_middle_out_order());
+
+constexpr std::array<int, 6> editedTable = [] {
+    StaticContainer<int, 8> container;
+    for (int v : {5, 3, 5, 9, 1, 7, 2})
+        container.addElement(v);
+    container.removeElement(5);
+    container.removeOne(2);
+    container.addElement(4);
+    return tableFrom(container.begin_descending_order(), container.end_descending_order());
+}();
+
+TEST_CASE("constexpr StaticContainer and orders") {
+    static_assert(ascendingTable == std::array<int, 6>{10, 20, 30, 40, 50, 60});
+    static_assert(sideCrossTable == std::array<int, 6>{10, 60, 20, 50, 30, 40});
+    static_assert(middleOutTable == std::array<int, 6>{30, 60, 20, 10, 50, 40});
+    static_assert(editedTable == std::array<int, 6>{9, 7, 4, 3, 1, 0});
+    static_assert(*configTable.begin_reverse_order() == 50);
+
+    // The same code paths give the same answers at runtime
+    StaticContainer<int, 8> runtime{40, 10, 60, 30, 20, 50};
+    CHECK((tableFrom(runtime.begin_ascending_order(), runtime.end_ascending_order()) == ascendingTable));
+    CHECK((tableFrom(runtime.begin_middle_out_order(), runtime.end_middle_out_order()) == middleOutTable));
+    CHECK_THROWS_AS((StaticContainer<int, 2>{1, 2, 3}), std::length_error);
+}
+#endif
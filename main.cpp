@@ -63,6 +63,13 @@ int main() {
         std::cout << "Caught exception: " << e.what() << std::endl;
     }
 
+    // Non-throwing removal for hot paths where misses are expected
+    container.addElement(7);
+    std::cout << "\nAdded another 7: " << container << std::endl;
+    std::cout << "removeOne(7) removed the first 7: " << std::boolalpha << container.removeOne(7) << std::endl;
+    std::cout << "After removeOne: " << container << std::endl;
+    std::cout << "tryRemoveElement(100) removed " << container.tryRemoveElement(100) << " elements" << std::endl;
+
     // Test behavior with an empty container
     const MyContainer<int> empty;
     std::cout << "\nTesting empty container..." << std::endl;